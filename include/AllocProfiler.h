@@ -0,0 +1,99 @@
+#pragma once
+#include <string>
+#include <vector>
+
+/**
+ * @brief Opt-in heap allocation counters (build with `make ALLOC_PROFILE=1`).
+ *
+ * The profiling build replaces global operator new/delete and charges every
+ * allocation to the current simulation phase and call-site category, which
+ * the code marks with LB_ALLOC_PHASE / LB_ALLOC_SITE scopes. In a normal
+ * build the macros expand to nothing and enabled() is false.
+ *
+ * "Per cycle" and "steady state" both cover only the simulation phases
+ * (arrivals through logging). Setup, measurement (PHASE_STATS) and summary
+ * work are reported per phase but never charged to the cycle path.
+ */
+namespace AllocProfiler {
+    enum Phase {
+        PHASE_SETUP = 0,    // construction, initial queue, anything unmarked
+        PHASE_ARRIVALS,
+        PHASE_DISPATCH,
+        PHASE_SERVICE,
+        PHASE_SCALING,
+        PHASE_LOGGING,
+        PHASE_STATS,        // steady-state detector, metrics export (measuring, not simulating)
+        PHASE_SUMMARY,
+        PHASE_COUNT
+    };
+
+    enum Site {
+        SITE_OTHER = 0,
+        SITE_REQUEST_GEN,   // RequestFactory (IP strings)
+        SITE_QUEUE,         // per-class deques
+        SITE_SERVER_ASSIGN, // Request copies into WebServer slots
+        SITE_SERVER_INDEX,  // idle/open server indexes
+        SITE_LOG_MESSAGE,   // console/log strings
+        SITE_COUNT
+    };
+
+    struct Counts {
+        long long allocs = 0;
+        long long bytes = 0;
+    };
+
+    bool enabled();
+
+    /**
+     * @brief True for the phases that make up one simulated cycle.
+     */
+    inline bool isCyclePhase(Phase p) { return p >= PHASE_ARRIVALS && p <= PHASE_LOGGING; }
+
+    Counts byPhase(Phase p);
+    Counts bySite(Site s);
+    Counts total();
+
+    /**
+     * @brief Simulation-phase allocations on the calling thread count as steady state from now on.
+     */
+    void beginSteadyState();
+    void endSteadyState();
+    Counts steadyState();
+
+    /**
+     * @brief Failure line if steady state (begun after afterCycle) allocated, else empty.
+     */
+    std::string steadyStateFailure(long long afterCycle);
+
+    /**
+     * @brief Summary lines: totals, per-phase, per-site, per request and per cycle.
+     *
+     * Counters are process-wide, so pass totals across every LoadBalancer.
+     */
+    std::vector<std::string> reportLines(long long processed, long long cycles);
+
+    // RAII markers (used through the macros below)
+    class PhaseScope {
+    public:
+        explicit PhaseScope(Phase p);
+        ~PhaseScope();
+    private:
+        Phase prev_;
+    };
+
+    class SiteScope {
+    public:
+        explicit SiteScope(Site s);
+        ~SiteScope();
+    private:
+        Site prev_;
+    };
+}
+
+#ifdef LB_ALLOC_PROFILE
+#define LB_ALLOC_PHASE(p) AllocProfiler::PhaseScope lbAllocPhase_(AllocProfiler::p)
+#define LB_ALLOC_SITE(s) AllocProfiler::SiteScope lbAllocSite_(AllocProfiler::s)
+#else
+#define LB_ALLOC_PHASE(p) ((void)0)
+#define LB_ALLOC_SITE(s) ((void)0)
+#endif
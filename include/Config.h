@@ -1,4 +1,55 @@
 #pragma once
+#include <string>
+#include <vector>
+
+/// Upper bound on priority classes (one bit per class in the non-empty bitmap).
+constexpr int MAX_PRIORITY_CLASSES = 32;
+
+/**
+ * @brief What to do with arrivals once a LoadBalancer queue reaches queueCapacity.
+ */
+enum ShedPolicy {
+    SHED_REJECT_NEW = 0,    // refuse the incoming request
+    SHED_DROP_OLDEST = 1,   // evict the request at the front of the queue
+    SHED_DROP_LONGEST = 2,  // evict the queued request with the largest time_required
+    SHED_EARLY_DROP = 3     // drop arrivals with a chance that rises with occupancy
+};
+
+/**
+ * @brief How a LoadBalancer picks the next priority class to dispatch from.
+ */
+enum SchedPolicy {
+    SCHED_STRICT = 0,       // always the highest non-empty class
+    SCHED_DRR = 1           // deficit round robin, weighted by classWeights
+};
+
+/**
+ * @brief Shape of the per-cycle arrival process (mean rate is newRequestProb).
+ */
+enum ArrivalModel {
+    ARRIVAL_BERNOULLI = 0,  // at most one arrival per cycle with chance newRequestProb
+    ARRIVAL_MMPP = 1,       // Markov-modulated Poisson: calm / burst states
+    ARRIVAL_DIURNAL = 2,    // Poisson with a sinusoidal rate curve
+    ARRIVAL_FLASH_CROWD = 3 // Poisson that jumps at flashStart and decays back
+};
+
+/**
+ * @brief Distribution of time_required.
+ */
+enum TaskTimeModel {
+    TASK_UNIFORM = 0,       // uniform over [taskTimeMin, taskTimeMax]
+    TASK_PARETO = 1,        // Pareto, scale taskTimeMin, alpha taskTimeShape
+    TASK_LOGNORMAL = 2      // lognormal, median mid-range, sigma taskTimeShape
+};
+
+/**
+ * @brief Capacity profile of one kind of WebServer instance.
+ */
+struct ServerClass {
+    double procSpeed = 1.0;     // work per cycle on 'P' jobs
+    double streamSpeed = 1.0;   // work per cycle on each 'S' job
+    int slots = 1;              // concurrent 'S' jobs ('P' jobs take the whole server)
+};
 
 /**
  * @brief Holds all configurable parameters for the load balancer simulation.
@@ -18,9 +69,56 @@ struct Config {
 
     double newRequestProb = 0.30;     // chance each cycle to generate a new request
 
+    int seed = 0;                     // 0 = random each run, otherwise reproducible RNG seed
+    int arrivalModel = ARRIVAL_BERNOULLI; // see ArrivalModel
+    double burstMultiplier = 4.0;     // MMPP burst / flash crowd peak rate, x newRequestProb
+    double mmppToBurstProb = 0.001;   // MMPP: per-cycle chance calm -> burst
+    double mmppToCalmProb = 0.01;     // MMPP: per-cycle chance burst -> calm
+    int diurnalPeriod = 10000;        // diurnal: cycles per "day"
+    double diurnalAmplitude = 0.8;    // diurnal: rate swing as a fraction of newRequestProb
+    int flashStart = 2000;            // flash crowd: onset cycle
+    int flashDecay = 1000;            // flash crowd: cycles to decay by 1/e
+    int taskTimeModel = TASK_UNIFORM; // see TaskTimeModel
+    double taskTimeShape = 1.5;       // Pareto alpha / lognormal sigma
+    int taskTimeCap = 1000;           // heavy-tailed task times are clamped to this
+
     int blockedChancePercent = 10;          // chance to block a request when queue is full
     int logVerboseDrops = 1;             // 0 = no logging, 1 = log blocked requests, 2 = log all drops (blocked + scaled down)
     int logCheckpointInterval = 1000;          // log status every N cycles
 
     int useColor = 1;
+
+    int queueCapacity = 0;            // max queued requests per LB (0 = unbounded)
+    int shedPolicy = SHED_REJECT_NEW; // see ShedPolicy
+    double earlyDropMinFill = 0.5;    // early drop: fill fraction where drop chance starts rising
+
+    int numPriorityClasses = 1;       // request classes, 0 = highest (shortest jobs)
+    int schedPolicy = SCHED_STRICT;   // see SchedPolicy
+    std::vector<int> classWeights;    // DRR weight per class (empty = numPriorityClasses - class)
+    int drrQuantum = 0;               // DRR work per weight unit per round (0 = taskTimeMax)
+
+    std::vector<ServerClass> serverClasses; // server i gets class i % size (empty = one baseline class)
+    double procCostFactor = 1.0;      // work per unit of time_required for 'P' jobs
+    double streamCostFactor = 1.0;    // work per unit of time_required for 'S' jobs
+
+    int steadyStateMode = 0;          // 1 = stop once steady-state confidence intervals are tight
+    int ssBatchSize = 100;            // cycles per batch mean
+    int ssMinBatches = 20;            // post-warm-up batches required before stopping
+    double ssTolerance = 0.05;        // max CI half-width as a fraction of the mean
+    int ssMinCycles = 20000;          // post-warm-up cycles required before stopping
+
+    int liveTcpPort = 9412;           // live mode: loopback TCP port (0 = off)
+    std::string liveUnixPath = "/tmp/loadbalancer.sock"; // live mode: Unix socket (empty = off)
+    int liveTickHz = 1000;            // live mode: simulation cycles per second
+    int liveReadBatch = 4096;         // live mode: max records per socket read
+    int liveUseSwitch = 0;            // live mode: 1 = route through Switch instead of one LB
+
+    int allocSteadyStateAfter = 0;    // ALLOC_PROFILE builds: cycle where steady state starts (0 = off)
+    int allocFailOnSteadyState = 0;   // 1 = fail the run if steady-state allocations are non-zero
+
+    int metricsFormat = 0;            // 0 = off, 1 = CSV, 2 = OpenMetrics text
+    int metricsWindow = 100;          // cycles per exported sample
+    int metricsBufferSize = 65536;    // samples held in each LB's ring buffer (room for metricsWindow=1)
+    std::string metricsDir = "logs";  // files are <dir>/metrics_<LB name>.csv|.om
+    int metricsCycleMs = 1;           // OpenMetrics timestamps: run start + cycle * this many ms
 };
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Config.h"
+#include "Request.h"
+
+/**
+ * @class LiveFrontend
+ * @brief Non-blocking epoll front-end that feeds real requests into the simulation.
+ *
+ * Listens on TCP and/or a Unix domain socket, reads WireFormat records in
+ * batches and hands each decoded Request to the sink (LoadBalancer::addRequest
+ * or Switch::route), which reports whether it was queued. A timerfd in the same epoll set drives the cycle clock
+ * at cfg.liveTickHz. Linux only.
+ */
+class LiveFrontend {
+public:
+    using Sink = std::function<bool(const Request&)>;
+    using Tick = std::function<void()>;
+
+    LiveFrontend(const Config& cfg, Sink sink, Tick tick);
+    ~LiveFrontend();
+
+    /**
+     * @brief Open the listeners and the tick timer.
+     * @return false if nothing could be opened.
+     */
+    bool start();
+
+    /**
+     * @brief Run the event loop until `cycles` ticks have executed.
+     */
+    void run(int cycles);
+
+    /**
+     * @brief Ingest throughput and per-admission latency.
+     */
+    void printSummary() const;
+
+private:
+    struct Connection {
+        std::vector<uint8_t> buf;
+        std::size_t filled = 0;
+    };
+
+    const Config& cfg_;
+    Sink sink_;
+    Tick tick_;
+
+    int epollFd_ = -1;
+    int timerFd_ = -1;
+    int tcpFd_ = -1;
+    int unixFd_ = -1;
+    std::unordered_map<int, Connection> conns_;
+
+    // ingest stats
+    long long received_ = 0;      // decoded records
+    long long admitted_ = 0;      // records the sink queued
+    long long bytesRead_ = 0;
+    long long reads_ = 0;
+    long long connectionsAccepted_ = 0;
+    long long ticks_ = 0;
+    long long admitNs_ = 0;       // decode + admission time
+    long long maxBatchNs_ = 0;
+    double wallSeconds_ = 0.0;
+
+    bool addToEpoll(int fd);
+    void acceptAll(int listenFd);
+    void readConnection(int fd);
+    void closeConnection(int fd);
+};
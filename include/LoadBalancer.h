@@ -1,13 +1,18 @@
 #pragma once
-#include <queue>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <utility>
 #include <vector>
 #include <string>
 
 #include "Config.h"
 #include "Request.h"
 #include "RequestFactory.h"
+#include "ServerIndex.h"
 #include "WebServer.h"
 #include "Logger.h"
+#include "MetricsRecorder.h"
 
 /**
  * @class LoadBalancer
@@ -22,54 +27,116 @@ public:
                  bool internalArrivals = true);
 
     // --- UML methods ---
-    void addRequest(const Request& r);
+    bool addRequest(const Request& r); // false if the firewall or a full queue refused it
     void dispatch();
     void scaleServers();
     void generateSummary();
 
+    // extra lines for this LB's log file (before generateSummary closes it)
+    void logLine(const std::string& line);
+
     // tiny getters for Switch summary 
     const std::string& name() const { return name_; }
-    int queueSize() const { return (int)q_.size(); }
+    int queueSize() const { return queued_; }
     int serverCount() const { return (int)servers_.size(); }
     long long processed() const { return processed_; }
     long long dropped() const { return dropped_; }
     long long generatedRandom() const { return generatedRandom_; }
+    long long shed() const { return shedRejected_ + shedOldest_ + shedLongest_ + shedEarly_; }
+    double averageWait() const; // cycles queued per dispatched request, all classes
 private:
     // config + randomness
     Config cfg_;
     RequestFactory factory_;
 
-    // core state
-    std::queue<Request> q_;
+    // core state: one FIFO per priority class + bitmap of non-empty classes
+    std::vector<std::deque<Request>> queues_;
+    uint32_t nonEmpty_ = 0;
+    int queued_ = 0;
+    std::vector<int> live_;            // per class: queued minus evicted tombstones
+    std::vector<long long> headSeq_;   // per class: sequence number of queues_[cls].front()
+
+    // drop-longest: per-class max-heap of (time_required, seq), stale entries skipped lazily
+    bool trackLongest_ = false;
+    std::vector<std::vector<std::pair<int, long long>>> longest_;
     std::vector<WebServer> servers_;
 
+    // servers that can take work right now, fastest class first
+    ServerIndex idleByProc_;    // fully idle ('P' candidates)
+    ServerIndex openByStream_;  // free slot, no 'P' job ('S' candidates)
+
     // time tracking (for cooldown)
     int currentTime_ = 0;
     int cooldownRemaining_ = 0;
+    long long shedAtLastScaleCheck_ = 0; // shedding since then counts as scale-up pressure
 
     // stats for logging/summary
     int startingQueueSize_ = 0;
     int endingQueueSize_ = 0;
     long long generatedRandom_ = 0;
     long long processed_ = 0;
+    long long arrivals_ = 0; // every addRequest call
     long long dropped_ = 0; // firewall later
+    long long shedRejected_ = 0; // queue full, arrival refused
+    long long shedOldest_ = 0;   // evicted from the front
+    long long shedLongest_ = 0;  // evicted for having the largest time_required
+    long long shedEarly_ = 0;    // early (probabilistic) drops
     long long serversAdded_ = 0;
     long long serversRemoved_ = 0;
     int peakQueue_ = 0;
     int peakServers_ = 0;
+    int busyServers_ = 0;    // as of the last tickServers()
+
+    // deficit round robin state
+    std::vector<long long> deficit_;
+    int drrCursor_ = 0;
+    bool drrFresh_ = true; // cursor class has not received its quantum yet
+
+    // per-class stats for the summary
+    struct ClassStats {
+        long long enqueued = 0;
+        long long dispatched = 0;
+        long long shed = 0;
+        long long totalWait = 0;
+        int maxWait = 0;
+    };
+    std::vector<ClassStats> classStats_;
 
     std::string name_;
     bool internalArrivals_ = true;
 
     // internal helpers (private)
     void initServers();
+    WebServer makeServer(int id) const;     // applies cfg_.serverClasses
+    void reindexServer(int idx);            // O(1) refresh of idleByProc_/openByStream_
+    int pickServer(const Request& r) const; // fastest suitable server or -1
+    int serviceCycles(const Request& r, const WebServer& s) const;
     void fillInitialQueue();
     void tickServers();
-    void maybeGenerateRandomRequest(); // uses cfg_.newRequestProb
+    void maybeGenerateRandomRequest(); // cfg_.arrivalModel via factory_
     void addServer();
     void removeServerIfPossible();
 
     bool isBlockedIP(const std::string& ip) const;
+    bool makeRoomFor(const Request& r); // applies queueCapacity + shedPolicy
+    void enqueue(const Request& r);
+    void dropFront(int cls);
+    void evict(int cls, long long seq);   // O(1): tombstones the entry in place
+    void settleFront(int cls);            // pops tombstones, clears the class when empty
+    long long longestQueued(int cls);     // seq of the longest live request, amortized O(log n)
+    void rebuildLongest(int cls);
+    int lowestNonEmptyClass() const;
+    int nextNonEmptyClass(int from) const;
+    int pickClass();                    // O(1) via nonEmpty_ bitmap
+    Request popClass(int cls);
+    std::vector<std::string> classSummaryLines() const;
+    std::string serverClassesText() const;
+    void noteShed(const std::string& reason, long long& counter, int cls);
 
     Logger* logger_ = nullptr;
+
+    // time-series export (null when metricsFormat = 0)
+    std::unique_ptr<MetricsRecorder> metrics_;
+    MetricsSample lastSample_;   // cumulative counters at the previous window
+    void recordMetrics();
 };
\ No newline at end of file
@@ -0,0 +1,112 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief One metrics window for a LoadBalancer.
+ *
+ * Gauges are the state at the end of the window; arrivals, drops and
+ * completions are totals over the window.
+ */
+struct MetricsSample {
+    long long cycle = 0;
+    int queue = 0;
+    int servers = 0;
+    int busy = 0;
+    int idle = 0;
+    long long arrivals = 0;
+    long long drops = 0;        // firewall + shed
+    long long completions = 0;
+    long long gapBefore = 0;    // set by MetricsRecorder: samples dropped just before this one
+};
+
+/**
+ * @class MetricsRecorder
+ * @brief Time-series export through a preallocated single-producer ring buffer.
+ *
+ * record() copies a sample into the ring without allocating and wakes a
+ * background writer once the ring is a quarter full (the writer also polls
+ * every 100 ms). On a full ring record() yields to the writer for up to
+ * 10 ms; only then is the sample dropped, counted as an overrun and marked
+ * in the output as a gap ("# gap" comment in CSV, the lb_metrics_dropped
+ * counter in OpenMetrics).
+ *
+ * CSV streams straight to the output file. OpenMetrics needs every line of
+ * a metric family in one block, so the writer appends each family to its
+ * own <path>.<family>.part file and close() stitches them together behind
+ * the HELP/TYPE headers and a final "# EOF". Timestamps are the wall-clock
+ * start of the run plus cycleMs per simulated cycle.
+ */
+class MetricsRecorder {
+public:
+    enum Format { FORMAT_CSV = 1, FORMAT_OPENMETRICS = 2 };
+    static constexpr int GAUGE_COUNT = 7;
+    static constexpr int FAMILY_COUNT = GAUGE_COUNT + 1; // gauges + the dropped-samples counter
+
+    MetricsRecorder(const std::string& path, const std::string& lbName, int format,
+                    int capacity, int cycleMs);
+    ~MetricsRecorder();
+
+    void record(const MetricsSample& s);
+
+    /**
+     * @brief Drain everything still buffered, stop the writer thread and finish the file.
+     */
+    void close();
+
+    /**
+     * @brief False if the output could not be opened or a write failed.
+     */
+    bool ok() const { return !failed_.load(); }
+
+    const std::string& path() const { return path_; }
+    long long written() const { return written_.load(); }
+    long long overruns() const { return overruns_; }
+
+private:
+    std::string path_;
+    std::string lbName_;
+    int format_;
+    long long startMs_;                 // OpenMetrics time base (ms since the epoch)
+    int cycleMs_;
+    std::ofstream out_;                 // CSV file
+    std::ofstream parts_[FAMILY_COUNT]; // OpenMetrics per-family spill files
+    std::atomic<bool> failed_{false};
+
+    std::vector<MetricsSample> ring_;
+    uint64_t wakeAt_;                   // fill level that wakes the writer
+    std::atomic<uint64_t> head_{0};     // next slot to fill (producer)
+    std::atomic<uint64_t> tail_{0};     // next slot to write (writer)
+    long long overruns_ = 0;            // producer-only
+    long long pendingGap_ = 0;          // producer-only: drops not yet attached to a sample
+    long long lastDroppedCycle_ = 0;    // producer-only
+    std::atomic<long long> written_{0};
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::atomic<bool> stop_{false};
+    std::thread writer_;
+
+    // writer-thread only (and close() once the writer has stopped)
+    std::string prefix_[FAMILY_COUNT];  // OpenMetrics "name{lb=\"X\"} " per family
+    std::size_t lineMax_ = 0;           // longest line one sample can add to a buffer
+    std::vector<char> buf_[FAMILY_COUNT]; // formatted output of one drain (CSV: buf_[0] only)
+    char* pos_[FAMILY_COUNT] = {};      // write position in each buf_
+    long long droppedTotal_ = 0;        // gaps written so far (OpenMetrics counter value)
+
+    std::string partPath(int family) const;
+    void wakeWriter();
+    void writerLoop();
+    void drain();
+    void startBuffers(std::size_t samples);
+    bool flushBuffers();
+    void writeSample(const MetricsSample& s);
+    void writeGap(long long dropped, long long cycle, bool trailing);
+    void finishOpenMetrics();
+};
@@ -0,0 +1,64 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "Config.h"
+
+/**
+ * @class QueueEstimator
+ * @brief Analytic M/G/c approximation of a single LoadBalancer.
+ *
+ * Arrivals are the Bernoulli-per-cycle process thinned by the firewall,
+ * service times come from the uniform task-time range (with job-type cost
+ * factors and server classes applied), and the queue is approximated with
+ * Erlang-C plus the Allen-Cunneen correction. Queue capacity and priority
+ * classes are not modelled.
+ */
+class QueueEstimator {
+public:
+    /**
+     * @brief Predicted steady-state figures for a fixed server count.
+     */
+    struct Estimate {
+        int servers = 0;
+        double channels = 0.0;     // servers weighted by streaming slots
+        double arrivalRate = 0.0;  // admitted requests per cycle
+        double meanService = 0.0;  // cycles
+        double utilization = 0.0;  // per channel
+        double probWait = 0.0;     // Erlang-C
+        double queueLength = 0.0;  // Lq
+        double waitTime = 0.0;     // Wq, cycles
+        double throughput = 0.0;   // completions per cycle (saturation rate when unstable)
+        bool stable = false;
+    };
+
+    /**
+     * @brief Where the threshold autoscaler in scaleServers() comes to rest.
+     */
+    struct AutoscalePrediction {
+        int low = 0;               // fewest servers that stop scale-up
+        int high = 0;              // most servers that stop scale-down
+        int settle = 0;            // starting from cfg.numServers
+        bool oscillates = false;   // no server count satisfies both thresholds
+    };
+
+    explicit QueueEstimator(const Config& cfg);
+
+    Estimate estimate(int servers) const;
+    AutoscalePrediction predictAutoscaler() const;
+
+    /**
+     * @brief Report lines for an estimate and autoscaler prediction.
+     */
+    std::vector<std::string> reportLines(const Estimate& e, const AutoscalePrediction& a) const;
+
+private:
+    Config cfg_;
+    double lambda_ = 0.0;      // arrivals per cycle after the firewall
+    double arrivalScv_ = 0.0;  // squared coefficient of variation of inter-arrivals
+    double meanService_ = 0.0;
+    double serviceScv_ = 0.0;
+
+    double channelWeight(int serverId) const;
+    double channelsFor(int servers) const;
+    Estimate fromErlangB(int servers, double channels, double erlangB) const;
+};
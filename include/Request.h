@@ -10,6 +10,8 @@ struct Request {
     std::string ip_out;     ///< destination/result IP address
     int time_required;      ///< processing time in clock cycles
     char job_type;          ///< 'P' (processing) or 'S' (streaming)
+    int priority = 0;       ///< priority class, 0 = highest
+    int arrival_time = 0;   ///< LB cycle the request was queued (for wait stats)
 
     /**
      * @brief Convert the request to a readable string (for logging/debug).
@@ -17,6 +19,7 @@ struct Request {
     std::string toString() const {
         return ip_in + " -> " + ip_out +
                " | time=" + std::to_string(time_required) +
-               " | type=" + std::string(1, job_type);
+               " | type=" + std::string(1, job_type) +
+               " | class=" + std::to_string(priority);
     }
 };
\ No newline at end of file
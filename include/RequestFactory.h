@@ -1,24 +1,33 @@
 #pragma once
+#include <algorithm>
+#include <cmath>
 #include <random>
 #include <string>
 #include "Config.h"
 #include "Request.h"
+#include "AllocProfiler.h"
 
 /**
  * @class RequestFactory
- * @brief Generates random Request objects for the simulation.
+ * @brief Generates random Request objects and per-cycle arrival counts for the simulation.
+ *
+ * Arrival and task-time shapes come from cfg.arrivalModel / cfg.taskTimeModel.
+ * Every draw is O(1) per arrival. With cfg.seed != 0 the sequence is
+ * reproducible; `stream` keeps factories that share a Config independent.
  */
 class RequestFactory {
 public:
-    explicit RequestFactory(const Config& cfg)
+    explicit RequestFactory(const Config& cfg, unsigned stream = 0)
         : cfg_(cfg),
-          rng_(std::random_device{}()),
+          rng_(makeRng(cfg, stream)),
           octetDist_(0, 255),
           timeDist_(cfg_.taskTimeMin, cfg_.taskTimeMax),
           jobDist_(0, 1),
-          blockChanceDist_(1, 100) {}
+          blockChanceDist_(1, 100),
+          lognormalDist_(std::log((cfg_.taskTimeMin + cfg_.taskTimeMax) / 2.0), cfg_.taskTimeShape) {}
 
     Request makeRequest() {
+        LB_ALLOC_SITE(SITE_REQUEST_GEN);
         Request r;
 
         // Generate normal random IP
@@ -32,12 +41,61 @@ public:
         }
 
         r.ip_out = randomIP();
-        r.time_required = timeDist_(rng_);
+        r.time_required = taskTime();
         r.job_type = (jobDist_(rng_) == 0) ? 'P' : 'S';
+        r.priority = priorityFor(r.time_required);
 
         return r;
     }
 
+    /**
+     * @brief Number of requests arriving in the given cycle.
+     */
+    int arrivalsAt(int cycle) {
+        if (cfg_.arrivalModel == ARRIVAL_BERNOULLI) {
+            return chance(cfg_.newRequestProb) ? 1 : 0;
+        }
+
+        double rate = cfg_.newRequestProb;
+        if (cfg_.arrivalModel == ARRIVAL_MMPP) {
+            // two-state Markov chain: calm <-> burst
+            if (chance(bursting_ ? cfg_.mmppToCalmProb : cfg_.mmppToBurstProb)) bursting_ = !bursting_;
+            if (bursting_) rate *= cfg_.burstMultiplier;
+        } else if (cfg_.arrivalModel == ARRIVAL_DIURNAL) {
+            const double TWO_PI = 6.283185307179586;
+            double phase = TWO_PI * cycle / cfg_.diurnalPeriod;
+            rate *= 1.0 + cfg_.diurnalAmplitude * std::sin(phase);
+        } else if (cfg_.arrivalModel == ARRIVAL_FLASH_CROWD && cycle >= cfg_.flashStart) {
+            // jump to burstMultiplier x base at flashStart, decay back exponentially
+            double age = (double)(cycle - cfg_.flashStart) / cfg_.flashDecay;
+            rate *= 1.0 + (cfg_.burstMultiplier - 1.0) * std::exp(-age);
+        }
+
+        if (rate <= 0.0) return 0;
+        poissonDist_.param(std::poisson_distribution<int>::param_type(rate));
+        return poissonDist_(rng_);
+    }
+
+    /**
+     * @brief Bernoulli draw from this factory's generator (keeps seeded runs reproducible).
+     */
+    bool chance(double p) {
+        return unitDist_(rng_) < p;
+    }
+
+    /**
+     * @brief Long-run mean arrivals per cycle for a config's arrival model.
+     */
+    static double meanArrivalRate(const Config& cfg) {
+        if (cfg.arrivalModel == ARRIVAL_MMPP) {
+            double toBurst = cfg.mmppToBurstProb, toCalm = cfg.mmppToCalmProb;
+            double burstShare = (toBurst + toCalm) > 0.0 ? toBurst / (toBurst + toCalm) : 0.0;
+            return cfg.newRequestProb * (1.0 - burstShare + burstShare * cfg.burstMultiplier);
+        }
+        // diurnal averages out over a period; a flash crowd is a transient
+        return cfg.newRequestProb;
+    }
+
 private:
     const Config& cfg_;
     std::mt19937 rng_;
@@ -46,6 +104,39 @@ private:
     std::uniform_int_distribution<int> timeDist_;
     std::uniform_int_distribution<int> jobDist_;
     std::uniform_int_distribution<int> blockChanceDist_;
+    std::uniform_real_distribution<double> unitDist_{0.0, 1.0};
+    std::poisson_distribution<int> poissonDist_;
+    std::lognormal_distribution<double> lognormalDist_;
+
+    bool bursting_ = false; // MMPP state
+
+    static std::mt19937 makeRng(const Config& cfg, unsigned stream) {
+        if (cfg.seed == 0) return std::mt19937(std::random_device{}());
+        std::seed_seq seq{(unsigned)cfg.seed, stream};
+        return std::mt19937(seq);
+    }
+
+    int taskTime() {
+        double t;
+        if (cfg_.taskTimeModel == TASK_PARETO) {
+            // inverse CDF: x_m / U^(1/alpha), x_m = taskTimeMin
+            double u = 1.0 - unitDist_(rng_);
+            t = cfg_.taskTimeMin / std::pow(u, 1.0 / cfg_.taskTimeShape);
+        } else if (cfg_.taskTimeModel == TASK_LOGNORMAL) {
+            // median at the middle of [taskTimeMin, taskTimeMax], sigma = taskTimeShape
+            t = lognormalDist_(rng_);
+        } else {
+            return timeDist_(rng_);
+        }
+        return (int)std::min(std::max(std::ceil(t), (double)cfg_.taskTimeMin), (double)cfg_.taskTimeCap);
+    }
+
+    // split [taskTimeMin, taskTimeMax] into equal bands: shorter jobs get higher priority
+    int priorityFor(int timeRequired) const {
+        int span = cfg_.taskTimeMax - cfg_.taskTimeMin + 1;
+        int cls = (timeRequired - cfg_.taskTimeMin) * cfg_.numPriorityClasses / span;
+        return std::min(cls, cfg_.numPriorityClasses - 1); // heavy-tail jobs land in the last class
+    }
 
     std::string randomIP() {
         return std::to_string(octetDist_(rng_)) + "." +
@@ -53,4 +144,4 @@ private:
                std::to_string(octetDist_(rng_)) + "." +
                std::to_string(octetDist_(rng_));
     }
-};
\ No newline at end of file
+};
@@ -0,0 +1,97 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class ServerIndex
+ * @brief Allocation-free set of available servers, fastest class first.
+ *
+ * Server i belongs to class i % classes (matching LoadBalancer::makeServer).
+ * Each class keeps a two-level bitmap of its members, so set() is O(1) and
+ * first() is a ctz per level. Storage only grows when the pool reaches a new
+ * high-water mark; reserve() up front avoids even that.
+ */
+class ServerIndex {
+public:
+    /**
+     * @brief Forget every server; speeds[c] orders class c (higher = preferred).
+     */
+    void reset(const std::vector<double>& speeds) {
+        classes_.assign(speeds.size(), ClassBits());
+        order_.resize(speeds.size());
+        for (int c = 0; c < (int)speeds.size(); c++) order_[c] = c;
+        // equal speeds keep class order, so a single class picks the lowest index
+        std::stable_sort(order_.begin(), order_.end(),
+                         [&speeds](int a, int b) { return speeds[a] > speeds[b]; });
+    }
+
+    /**
+     * @brief Make room for server indexes [0, servers) without later growth.
+     */
+    void reserve(int servers) {
+        if (classes_.empty() || servers <= 0) return;
+        int perClass = (servers + (int)classes_.size() - 1) / (int)classes_.size();
+        for (ClassBits& cb : classes_) cb.grow(perClass - 1);
+    }
+
+    /**
+     * @brief Mark server idx available or not.
+     */
+    void set(int idx, bool available) {
+        int k = (int)classes_.size();
+        ClassBits& cb = classes_[idx % k];
+        int pos = idx / k;
+        int w = pos >> 6;
+        uint64_t bit = 1ULL << (pos & 63);
+
+        if (available) {
+            cb.grow(pos);
+            if (cb.words[w] & bit) return;
+            cb.words[w] |= bit;
+            cb.summary[w >> 6] |= 1ULL << (w & 63);
+            cb.count++;
+        } else {
+            if (w >= (int)cb.words.size() || !(cb.words[w] & bit)) return;
+            cb.words[w] &= ~bit;
+            if (cb.words[w] == 0) cb.summary[w >> 6] &= ~(1ULL << (w & 63));
+            cb.count--;
+        }
+    }
+
+    /**
+     * @brief Lowest-index available server of the fastest class that has one, or -1.
+     */
+    int first() const {
+        int k = (int)classes_.size();
+        for (int c : order_) {
+            const ClassBits& cb = classes_[c];
+            if (cb.count == 0) continue;
+
+            for (int s = 0; s < (int)cb.summary.size(); s++) {
+                if (cb.summary[s] == 0) continue;
+                int w = s * 64 + __builtin_ctzll(cb.summary[s]);
+                int pos = w * 64 + __builtin_ctzll(cb.words[w]);
+                return pos * k + c;
+            }
+        }
+        return -1;
+    }
+
+private:
+    struct ClassBits {
+        std::vector<uint64_t> words;   // bit p = server p*k + c is available
+        std::vector<uint64_t> summary; // bit w = words[w] != 0
+        int count = 0;
+
+        void grow(int pos) {
+            int needWords = (pos >> 6) + 1;
+            if ((int)words.size() >= needWords) return;
+            words.resize(needWords, 0);
+            summary.resize((needWords + 63) >> 6, 0);
+        }
+    };
+
+    std::vector<ClassBits> classes_;
+    std::vector<int> order_; // class indexes, fastest first
+};
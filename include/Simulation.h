@@ -1,6 +1,7 @@
 #pragma once
 #include "Config.h"
 #include "LoadBalancer.h"
+#include "SteadyStateDetector.h"
 
 /**
  * @class Simulation
@@ -8,14 +9,32 @@
  */
 class Simulation {
 public:
-    explicit Simulation(const Config& cfg);
+    /**
+     * @param collectStats feed steadyState() even when steadyStateMode is off (validation)
+     */
+    explicit Simulation(const Config& cfg, bool collectStats = false);
 
     // --- UML method ---
     void runSimulation();
 
+    /**
+     * @brief Batch-means statistics of the last run (queue, servers, throughput).
+     *
+     * Empty unless steadyStateMode is on or collectStats was set.
+     */
+    const SteadyStateDetector& steadyState() const { return steady_; }
+
+    /**
+     * @brief False if allocFailOnSteadyState tripped (profiling builds only).
+     */
+    bool passed() const { return passed_; }
+
 private:
     int currentTime_;
     int maxTime_;
     Config cfg_;
     LoadBalancer lb_;
+    SteadyStateDetector steady_;
+    bool collectStats_;
+    bool passed_ = true;
 };
\ No newline at end of file
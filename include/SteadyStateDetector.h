@@ -0,0 +1,89 @@
+#pragma once
+#include <string>
+#include <vector>
+
+/**
+ * @class SteadyStateDetector
+ * @brief Batch-means steady-state detector with MSER warm-up truncation.
+ *
+ * Per-cycle samples of queue length, server count and throughput are
+ * folded into base batches of batchSize cycles. Each check groups the base
+ * batches (doubling the group while the retained batch means still show
+ * lag-1 autocorrelation), lets MSER pick the warm-up prefix to discard, and
+ * computes a 95% t-interval on the remaining means of every metric. The
+ * check runs every ~n/16 base batches, so a whole run costs O(n) overall.
+ */
+class SteadyStateDetector {
+public:
+    enum Metric { QUEUE = 0, SERVERS, THROUGHPUT, METRIC_COUNT };
+
+    struct Interval {
+        double mean = 0.0;
+        double halfWidth = 0.0;
+    };
+
+    /**
+     * @param minCycles post-warm-up cycles required before convergence can be declared
+     */
+    SteadyStateDetector(int batchSize, int minBatches, double tolerance, int minCycles);
+
+    /**
+     * @brief Record one cycle. Returns true once every metric has converged.
+     */
+    bool record(double queue, double servers, double throughput);
+
+    /**
+     * @brief Pre-size storage for a run of the given length.
+     */
+    void reserve(int cycles);
+
+    /**
+     * @brief Bring warm-up and intervals up to date with every closed batch.
+     */
+    void finish();
+
+    bool converged() const { return converged_; }
+    int warmupCycles() const { return warmupBatches_ * groupSize_ * batchSize_; }
+    int cyclesRecorded() const { return cycles_; }
+    int effectiveBatchSize() const { return groupSize_ * batchSize_; }
+    Interval interval(int metric) const { return intervals_[metric]; }
+
+    /**
+     * @brief Human-readable summary (warm-up, intervals, convergence).
+     */
+    std::vector<std::string> reportLines() const;
+
+private:
+    int batchSize_;
+    int minBatches_;
+    double tolerance_;
+    int minCycles_;
+
+    int cycles_ = 0;
+    int inBatch_ = 0;
+    double batchSum_[METRIC_COUNT] = {0.0, 0.0, 0.0};
+    std::vector<double> base_[METRIC_COUNT]; // base batch means
+    int baseBatches_ = 0;
+    int evaluatedAt_ = 0;  // baseBatches_ at the last evaluate()
+    int nextCheck_ = 0;    // base batch count that triggers the next evaluate()
+
+    // grouped series for the current check: groupSize_ base batches per mean
+    int groupSize_ = 1;
+    int batches_ = 0;
+    // prefix[i] = sum of the first i grouped means (and their squares), minus shift_
+    double shift_[METRIC_COUNT] = {0.0, 0.0, 0.0};
+    std::vector<double> prefix_[METRIC_COUNT];
+    std::vector<double> prefixSq_[METRIC_COUNT];
+
+    int warmupBatches_ = 0;
+    Interval intervals_[METRIC_COUNT];
+    double lag1_[METRIC_COUNT] = {0.0, 0.0, 0.0};
+    bool converged_ = false;
+
+    void closeBatch();
+    void evaluate();
+    void buildGroups();
+    bool checkGroups();
+    int mserTruncation(int metric) const;
+    double lag1(int metric, int from, double mean) const;
+};
@@ -9,11 +9,13 @@ class Switch {
 public:
     Switch(const Config& cfg,
            LoadBalancer& streamingLB,
-           LoadBalancer& processingLB);
+           LoadBalancer& processingLB,
+           bool internalArrivals = true);
 
-    void route(const Request& r);
+    bool route(const Request& r); // true if the target LB queued it
     void step();          // one simulation cycle
     void summary();       // combined + per-LB output
+    bool passed() const { return passed_; } // false if allocFailOnSteadyState tripped
 
 private:
     const Config& cfg_;
@@ -25,6 +27,8 @@ private:
     long long routedProc_ = 0;
 
     int time_ = 0;
+    bool internalArrivals_ = true;
+    bool passed_ = true;
 
-    void maybeGenerateAndRoute(); // uses cfg_.newRequestProb
+    void maybeGenerateAndRoute(); // cfg_.arrivalModel via factory_
 };
\ No newline at end of file
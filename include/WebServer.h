@@ -1,33 +1,58 @@
 #pragma once
-#include <optional>
+#include <vector>
 #include "Request.h"
 
 /**
  * @class WebServer
- * @brief Processes at most one Request at a time.
+ * @brief Processes requests in one or more concurrent slots.
+ *
+ * A 'P' (processing) job takes the whole server. 'S' (streaming) jobs
+ * share it, one per slot, up to the server's slot count.
  */
 class WebServer {
 public:
-    explicit WebServer(int id);
+    WebServer(int id, double procSpeed = 1.0, double streamSpeed = 1.0, int slots = 1);
 
     /**
-     * @brief Assign a request to this server (server must be idle).
+     * @brief Assign a request that will finish after `cycles` ticks (caller checks canAccept()).
      */
-    void assign(const Request& r);
+    void assign(const Request& r, int cycles);
 
     /**
      * @brief Process one clock cycle.
+     * @return number of requests that finished this cycle.
      */
-    void tick();
+    int tick();
 
     /**
-     * @brief True if the server is not currently processing a request.
+     * @brief True if the server is not currently processing any request.
      */
     bool isIdle() const;
 
+    /**
+     * @brief True if a job of the given type could start on this server right now.
+     */
+    bool canAccept(char jobType) const;
+
+    /**
+     * @brief Work done per cycle on jobs of the given type (1.0 = baseline server).
+     */
+    double speedFor(char jobType) const { return jobType == 'S' ? streamSpeed_ : procSpeed_; }
+
+    int id() const { return id_; }
+    int activeJobs() const { return active_; }
+
 private:
+    struct Slot {
+        bool busy = false;
+        int remaining = 0;
+        Request req;
+    };
+
     int id_;
-    bool busy_;
-    int remaining_;
-    std::optional<Request> current_;
-};
\ No newline at end of file
+    double procSpeed_;
+    double streamSpeed_;
+    int active_;
+    bool exclusive_; // running a 'P' job
+    std::vector<Slot> slots_;
+};
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Request.h"
+
+/**
+ * @brief Fixed-size binary request records for live ingestion.
+ *
+ * Every record is 16 bytes, little-endian:
+ *   [0..3]  ip_in  (a.b.c.d packed as a<<24 | b<<16 | c<<8 | d)
+ *   [4..7]  ip_out
+ *   [8..9]  time_required
+ *   [10]    job_type ('P' or 'S')
+ *   [11]    priority class
+ *   [12..15] sender sequence number
+ */
+namespace WireFormat {
+    constexpr std::size_t RECORD_SIZE = 16;
+
+    inline void putU32(uint8_t* p, uint32_t v) {
+        p[0] = (uint8_t)v;
+        p[1] = (uint8_t)(v >> 8);
+        p[2] = (uint8_t)(v >> 16);
+        p[3] = (uint8_t)(v >> 24);
+    }
+
+    inline uint32_t getU32(const uint8_t* p) {
+        return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+               ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+
+    inline uint32_t packIP(const std::string& ip) {
+        uint32_t out = 0;
+        uint32_t octet = 0;
+        for (char c : ip) {
+            if (c == '.') {
+                out = (out << 8) | (octet & 0xFF);
+                octet = 0;
+            } else if (c >= '0' && c <= '9') {
+                octet = octet * 10 + (uint32_t)(c - '0');
+            }
+        }
+        return (out << 8) | (octet & 0xFF);
+    }
+
+    inline std::string unpackIP(uint32_t ip) {
+        return std::to_string((ip >> 24) & 0xFF) + "." +
+               std::to_string((ip >> 16) & 0xFF) + "." +
+               std::to_string((ip >> 8) & 0xFF) + "." +
+               std::to_string(ip & 0xFF);
+    }
+
+    inline void encode(const Request& r, uint32_t seq, uint8_t* out) {
+        putU32(out, packIP(r.ip_in));
+        putU32(out + 4, packIP(r.ip_out));
+        int t = r.time_required < 0 ? 0 : (r.time_required > 0xFFFF ? 0xFFFF : r.time_required);
+        out[8] = (uint8_t)t;
+        out[9] = (uint8_t)(t >> 8);
+        out[10] = (uint8_t)r.job_type;
+        out[11] = (uint8_t)r.priority;
+        putU32(out + 12, seq);
+    }
+
+    inline Request decode(const uint8_t* in) {
+        Request r;
+        r.ip_in = unpackIP(getU32(in));
+        r.ip_out = unpackIP(getU32(in + 4));
+        r.time_required = (int)in[8] | ((int)in[9] << 8);
+        r.job_type = (in[10] == 'S') ? 'S' : 'P';
+        r.priority = in[11];
+        return r;
+    }
+}
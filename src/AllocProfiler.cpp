@@ -0,0 +1,182 @@
+#include "AllocProfiler.h"
+
+#ifdef LB_ALLOC_PROFILE
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    // plain arrays of atomics: no allocation of our own inside operator new
+    std::atomic<long long> g_allocs[AllocProfiler::PHASE_COUNT][AllocProfiler::SITE_COUNT];
+    std::atomic<long long> g_bytes[AllocProfiler::PHASE_COUNT][AllocProfiler::SITE_COUNT];
+    std::atomic<long long> g_steadyAllocs{0};
+    std::atomic<long long> g_steadyBytes{0};
+
+    // per thread, so the metrics writer and other helpers never count as steady state
+    thread_local bool t_inSteadyState = false;
+    thread_local AllocProfiler::Phase t_phase = AllocProfiler::PHASE_SETUP;
+    thread_local AllocProfiler::Site t_site = AllocProfiler::SITE_OTHER;
+
+    void record(std::size_t n) {
+        g_allocs[t_phase][t_site].fetch_add(1, std::memory_order_relaxed);
+        g_bytes[t_phase][t_site].fetch_add((long long)n, std::memory_order_relaxed);
+        if (t_inSteadyState && AllocProfiler::isCyclePhase(t_phase)) {
+            g_steadyAllocs.fetch_add(1, std::memory_order_relaxed);
+            g_steadyBytes.fetch_add((long long)n, std::memory_order_relaxed);
+        }
+    }
+
+    void* counted(std::size_t n) {
+        record(n);
+        void* p = std::malloc(n ? n : 1);
+        if (!p) throw std::bad_alloc();
+        return p;
+    }
+}
+
+void* operator new(std::size_t n) { return counted(n); }
+void* operator new[](std::size_t n) { return counted(n); }
+
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept {
+    record(n);
+    return std::malloc(n ? n : 1);
+}
+
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept {
+    record(n);
+    return std::malloc(n ? n : 1);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+namespace AllocProfiler {
+    bool enabled() { return true; }
+
+    Counts byPhase(Phase p) {
+        Counts c;
+        for (int s = 0; s < SITE_COUNT; s++) {
+            c.allocs += g_allocs[p][s].load();
+            c.bytes += g_bytes[p][s].load();
+        }
+        return c;
+    }
+
+    Counts bySite(Site s) {
+        Counts c;
+        for (int p = 0; p < PHASE_COUNT; p++) {
+            c.allocs += g_allocs[p][s].load();
+            c.bytes += g_bytes[p][s].load();
+        }
+        return c;
+    }
+
+    Counts total() {
+        Counts c;
+        for (int p = 0; p < PHASE_COUNT; p++) {
+            Counts pc = byPhase((Phase)p);
+            c.allocs += pc.allocs;
+            c.bytes += pc.bytes;
+        }
+        return c;
+    }
+
+    void beginSteadyState() { t_inSteadyState = true; }
+    void endSteadyState() { t_inSteadyState = false; }
+
+    Counts steadyState() {
+        Counts c;
+        c.allocs = g_steadyAllocs.load();
+        c.bytes = g_steadyBytes.load();
+        return c;
+    }
+
+    PhaseScope::PhaseScope(Phase p) : prev_(t_phase) { t_phase = p; }
+    PhaseScope::~PhaseScope() { t_phase = prev_; }
+
+    SiteScope::SiteScope(Site s) : prev_(t_site) { t_site = s; }
+    SiteScope::~SiteScope() { t_site = prev_; }
+}
+
+#else
+
+namespace AllocProfiler {
+    bool enabled() { return false; }
+    Counts byPhase(Phase) { return Counts(); }
+    Counts bySite(Site) { return Counts(); }
+    Counts total() { return Counts(); }
+    void beginSteadyState() {}
+    void endSteadyState() {}
+    Counts steadyState() { return Counts(); }
+
+    PhaseScope::PhaseScope(Phase p) : prev_(p) {}
+    PhaseScope::~PhaseScope() {}
+    SiteScope::SiteScope(Site s) : prev_(s) {}
+    SiteScope::~SiteScope() {}
+}
+
+#endif
+
+namespace AllocProfiler {
+    static const char* PHASE_NAMES[PHASE_COUNT] = {
+        "setup", "arrivals", "dispatch", "service", "scaling", "logging", "stats", "summary"
+    };
+    static const char* SITE_NAMES[SITE_COUNT] = {
+        "other", "request-gen", "queue", "server-assign", "server-index", "log-message"
+    };
+
+    static std::string countsText(const Counts& c) {
+        return std::to_string(c.allocs) + " allocs / " + std::to_string(c.bytes) + " bytes";
+    }
+
+    // processed and cycles must cover every LB in the process: the counters are global
+    std::vector<std::string> reportLines(long long processed, long long cycles) {
+        std::vector<std::string> lines;
+        if (!enabled()) return lines;
+
+        // snapshot first: building the report allocates (in the summary phase)
+        Counts phases[PHASE_COUNT];
+        Counts sites[SITE_COUNT];
+        for (int p = 0; p < PHASE_COUNT; p++) phases[p] = byPhase((Phase)p);
+        for (int s = 0; s < SITE_COUNT; s++) sites[s] = bySite((Site)s);
+        Counts steady = steadyState();
+
+        Counts all;
+        for (int p = 0; p < PHASE_COUNT; p++) {
+            all.allocs += phases[p].allocs;
+            all.bytes += phases[p].bytes;
+        }
+
+        lines.push_back("Allocations (process-wide): " + countsText(all));
+        for (int p = 0; p < PHASE_COUNT; p++) {
+            lines.push_back("  phase " + std::string(PHASE_NAMES[p]) + ": " + countsText(phases[p]));
+        }
+        for (int s = 0; s < SITE_COUNT; s++) {
+            lines.push_back("  site " + std::string(SITE_NAMES[s]) + ": " + countsText(sites[s]));
+        }
+
+        // the per-cycle path: the same phases the steady-state figure counts
+        long long loop = 0;
+        for (int p = 0; p < PHASE_COUNT; p++) {
+            if (isCyclePhase((Phase)p)) loop += phases[p].allocs;
+        }
+        lines.push_back("Allocations per processed request: " +
+                        std::to_string(processed > 0 ? (double)loop / processed : 0.0));
+        lines.push_back("Allocations per cycle: " +
+                        std::to_string(cycles > 0 ? (double)loop / cycles : 0.0));
+        lines.push_back("Steady-state allocations: " + countsText(steady));
+        return lines;
+    }
+
+    std::string steadyStateFailure(long long afterCycle) {
+        Counts steady = steadyState();
+        if (!enabled() || steady.allocs == 0) return "";
+        return "[Alloc] FAIL: " + std::to_string(steady.allocs) + " allocations (" +
+               std::to_string(steady.bytes) + " bytes) after cycle " + std::to_string(afterCycle);
+    }
+}
@@ -12,6 +12,38 @@ static inline std::string trim(const std::string& s) {
     return s.substr(start, end - start);
 }
 
+// "4,2,1" -> {4, 2, 1}
+static std::vector<int> parseIntList(const std::string& s) {
+    std::vector<int> out;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        item = trim(item);
+        if (!item.empty()) out.push_back(std::stoi(item));
+    }
+    return out;
+}
+
+// "2/1/1,1/2/4" -> procSpeed/streamSpeed/slots per server class
+static std::vector<ServerClass> parseServerClasses(const std::string& s) {
+    std::vector<ServerClass> out;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        item = trim(item);
+        if (item.empty()) continue;
+
+        std::stringstream fields(item);
+        std::string f;
+        ServerClass sc;
+        if (std::getline(fields, f, '/')) sc.procSpeed = std::stod(f);
+        if (std::getline(fields, f, '/')) sc.streamSpeed = std::stod(f);
+        if (std::getline(fields, f, '/')) sc.slots = std::stoi(f);
+        out.push_back(sc);
+    }
+    return out;
+}
+
 bool ConfigLoader::loadFromFile(const std::string& path, Config& cfg) {
     std::ifstream in(path);
     if (!in.is_open()) return false;
@@ -35,10 +67,49 @@ bool ConfigLoader::loadFromFile(const std::string& path, Config& cfg) {
             else if (key == "maxQueuePerServer") cfg.maxQueuePerServer = std::stoi(val);
             else if (key == "scaleCooldownN") cfg.scaleCooldownN = std::stoi(val);
             else if (key == "newRequestProb") cfg.newRequestProb = std::stod(val);
+            else if (key == "seed") cfg.seed = std::stoi(val);
+            else if (key == "arrivalModel") cfg.arrivalModel = std::stoi(val);
+            else if (key == "burstMultiplier") cfg.burstMultiplier = std::stod(val);
+            else if (key == "mmppToBurstProb") cfg.mmppToBurstProb = std::stod(val);
+            else if (key == "mmppToCalmProb") cfg.mmppToCalmProb = std::stod(val);
+            else if (key == "diurnalPeriod") cfg.diurnalPeriod = std::stoi(val);
+            else if (key == "diurnalAmplitude") cfg.diurnalAmplitude = std::stod(val);
+            else if (key == "flashStart") cfg.flashStart = std::stoi(val);
+            else if (key == "flashDecay") cfg.flashDecay = std::stoi(val);
+            else if (key == "taskTimeModel") cfg.taskTimeModel = std::stoi(val);
+            else if (key == "taskTimeShape") cfg.taskTimeShape = std::stod(val);
+            else if (key == "taskTimeCap") cfg.taskTimeCap = std::stoi(val);
             else if (key == "blockedChancePercent") cfg.blockedChancePercent = std::stoi(val);
             else if (key == "logVerboseDrops") cfg.logVerboseDrops = std::stoi(val);
             else if (key == "logCheckpointInterval") cfg.logCheckpointInterval = std::stoi(val);
             else if (key == "useColor") cfg.useColor = std::stoi(val);
+            else if (key == "queueCapacity") cfg.queueCapacity = std::stoi(val);
+            else if (key == "shedPolicy") cfg.shedPolicy = std::stoi(val);
+            else if (key == "earlyDropMinFill") cfg.earlyDropMinFill = std::stod(val);
+            else if (key == "numPriorityClasses") cfg.numPriorityClasses = std::stoi(val);
+            else if (key == "schedPolicy") cfg.schedPolicy = std::stoi(val);
+            else if (key == "classWeights") cfg.classWeights = parseIntList(val);
+            else if (key == "drrQuantum") cfg.drrQuantum = std::stoi(val);
+            else if (key == "serverClasses") cfg.serverClasses = parseServerClasses(val);
+            else if (key == "procCostFactor") cfg.procCostFactor = std::stod(val);
+            else if (key == "streamCostFactor") cfg.streamCostFactor = std::stod(val);
+            else if (key == "steadyStateMode") cfg.steadyStateMode = std::stoi(val);
+            else if (key == "ssBatchSize") cfg.ssBatchSize = std::stoi(val);
+            else if (key == "ssMinBatches") cfg.ssMinBatches = std::stoi(val);
+            else if (key == "ssTolerance") cfg.ssTolerance = std::stod(val);
+            else if (key == "ssMinCycles") cfg.ssMinCycles = std::stoi(val);
+            else if (key == "liveTcpPort") cfg.liveTcpPort = std::stoi(val);
+            else if (key == "liveUnixPath") cfg.liveUnixPath = val;
+            else if (key == "liveTickHz") cfg.liveTickHz = std::stoi(val);
+            else if (key == "liveReadBatch") cfg.liveReadBatch = std::stoi(val);
+            else if (key == "liveUseSwitch") cfg.liveUseSwitch = std::stoi(val);
+            else if (key == "allocSteadyStateAfter") cfg.allocSteadyStateAfter = std::stoi(val);
+            else if (key == "allocFailOnSteadyState") cfg.allocFailOnSteadyState = std::stoi(val);
+            else if (key == "metricsFormat") cfg.metricsFormat = std::stoi(val);
+            else if (key == "metricsWindow") cfg.metricsWindow = std::stoi(val);
+            else if (key == "metricsBufferSize") cfg.metricsBufferSize = std::stoi(val);
+            else if (key == "metricsDir") cfg.metricsDir = val;
+            else if (key == "metricsCycleMs") cfg.metricsCycleMs = std::stoi(val);
             // ignore unknown keys
         } catch (...) {
             // ignore bad values and keep defaults
@@ -57,6 +128,22 @@ bool ConfigLoader::loadFromFile(const std::string& path, Config& cfg) {
     if (cfg.newRequestProb < 0.0) cfg.newRequestProb = 0.0;
     if (cfg.newRequestProb > 1.0) cfg.newRequestProb = 1.0;
 
+    if (cfg.seed < 0) cfg.seed = 0;
+    if (cfg.arrivalModel < ARRIVAL_BERNOULLI || cfg.arrivalModel > ARRIVAL_FLASH_CROWD) cfg.arrivalModel = ARRIVAL_BERNOULLI;
+    if (cfg.burstMultiplier < 0.0) cfg.burstMultiplier = 0.0;
+    if (cfg.mmppToBurstProb < 0.0) cfg.mmppToBurstProb = 0.0;
+    if (cfg.mmppToBurstProb > 1.0) cfg.mmppToBurstProb = 1.0;
+    if (cfg.mmppToCalmProb < 0.0) cfg.mmppToCalmProb = 0.0;
+    if (cfg.mmppToCalmProb > 1.0) cfg.mmppToCalmProb = 1.0;
+    if (cfg.diurnalPeriod < 1) cfg.diurnalPeriod = 1;
+    if (cfg.diurnalAmplitude < 0.0) cfg.diurnalAmplitude = 0.0;
+    if (cfg.diurnalAmplitude > 1.0) cfg.diurnalAmplitude = 1.0;
+    if (cfg.flashStart < 0) cfg.flashStart = 0;
+    if (cfg.flashDecay < 1) cfg.flashDecay = 1;
+    if (cfg.taskTimeModel < TASK_UNIFORM || cfg.taskTimeModel > TASK_LOGNORMAL) cfg.taskTimeModel = TASK_UNIFORM;
+    if (cfg.taskTimeShape <= 0.0) cfg.taskTimeShape = 1.5;
+    if (cfg.taskTimeCap < cfg.taskTimeMax) cfg.taskTimeCap = cfg.taskTimeMax;
+
     if (cfg.blockedChancePercent < 0) cfg.blockedChancePercent = 0;
     if (cfg.blockedChancePercent > 100) cfg.blockedChancePercent = 100;
 
@@ -65,5 +152,47 @@ bool ConfigLoader::loadFromFile(const std::string& path, Config& cfg) {
 
     if (cfg.useColor != 0) cfg.useColor = 1;
 
+    if (cfg.queueCapacity < 0) cfg.queueCapacity = 0;
+    if (cfg.shedPolicy < SHED_REJECT_NEW || cfg.shedPolicy > SHED_EARLY_DROP) cfg.shedPolicy = SHED_REJECT_NEW;
+    if (cfg.earlyDropMinFill < 0.0) cfg.earlyDropMinFill = 0.0;
+    if (cfg.earlyDropMinFill > 1.0) cfg.earlyDropMinFill = 1.0;
+
+    if (cfg.numPriorityClasses < 1) cfg.numPriorityClasses = 1;
+    if (cfg.numPriorityClasses > MAX_PRIORITY_CLASSES) cfg.numPriorityClasses = MAX_PRIORITY_CLASSES;
+    if (cfg.schedPolicy != SCHED_DRR) cfg.schedPolicy = SCHED_STRICT;
+    for (int& w : cfg.classWeights) {
+        if (w < 1) w = 1;
+    }
+    if (cfg.drrQuantum < 0) cfg.drrQuantum = 0;
+
+    for (ServerClass& sc : cfg.serverClasses) {
+        if (sc.procSpeed <= 0.0) sc.procSpeed = 1.0;
+        if (sc.streamSpeed <= 0.0) sc.streamSpeed = 1.0;
+        if (sc.slots < 1) sc.slots = 1;
+    }
+    if (cfg.procCostFactor <= 0.0) cfg.procCostFactor = 1.0;
+    if (cfg.streamCostFactor <= 0.0) cfg.streamCostFactor = 1.0;
+
+    if (cfg.steadyStateMode != 0) cfg.steadyStateMode = 1;
+    if (cfg.ssBatchSize < 1) cfg.ssBatchSize = 1;
+    if (cfg.ssMinBatches < 2) cfg.ssMinBatches = 2;
+    if (cfg.ssTolerance <= 0.0) cfg.ssTolerance = 0.05;
+    if (cfg.ssMinCycles < 0) cfg.ssMinCycles = 0;
+
+    if (cfg.liveTcpPort < 0 || cfg.liveTcpPort > 65535) cfg.liveTcpPort = 0;
+    if (cfg.liveTickHz < 1) cfg.liveTickHz = 1;
+    if (cfg.liveTickHz > 1000000) cfg.liveTickHz = 1000000;
+    if (cfg.liveReadBatch < 1) cfg.liveReadBatch = 1;
+    if (cfg.liveUseSwitch != 0) cfg.liveUseSwitch = 1;
+
+    if (cfg.allocSteadyStateAfter < 0) cfg.allocSteadyStateAfter = 0;
+    if (cfg.allocFailOnSteadyState != 0) cfg.allocFailOnSteadyState = 1;
+
+    if (cfg.metricsFormat < 0 || cfg.metricsFormat > 2) cfg.metricsFormat = 0;
+    if (cfg.metricsWindow < 1) cfg.metricsWindow = 1;
+    if (cfg.metricsBufferSize < 2) cfg.metricsBufferSize = 2;
+    if (cfg.metricsDir.empty()) cfg.metricsDir = ".";
+    if (cfg.metricsCycleMs < 1) cfg.metricsCycleMs = 1;
+
     return true;
 }
\ No newline at end of file
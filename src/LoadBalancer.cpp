@@ -1,8 +1,12 @@
 #include "LoadBalancer.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <iostream>
 #include <random>
 #include <string>
 #include "ConsoleColor.h"
+#include "AllocProfiler.h"
 
 // helper: count busy vs idle servers (for logging checkpoints/summary)
 static void countServerStates(const std::vector<WebServer>& servers, int& busy, int& idle) {
@@ -22,17 +26,25 @@ LoadBalancer::LoadBalancer(const Config& cfg,
                            bool doFillInitialQueue,
                            bool internalArrivals)
     : cfg_(cfg),
-      factory_(cfg_),
+      factory_(cfg_, (unsigned)std::hash<std::string>{}(name)),
       name_(std::move(name)),
       internalArrivals_(internalArrivals) {
 
+    queues_.resize(cfg_.numPriorityClasses);
+    live_.assign(cfg_.numPriorityClasses, 0);
+    headSeq_.assign(cfg_.numPriorityClasses, 0);
+    trackLongest_ = cfg_.queueCapacity > 0 && cfg_.shedPolicy == SHED_DROP_LONGEST;
+    if (trackLongest_) longest_.resize(cfg_.numPriorityClasses);
+    deficit_.assign(cfg_.numPriorityClasses, 0);
+    classStats_.resize(cfg_.numPriorityClasses);
+
     initServers();
 
     if (doFillInitialQueue) {
         fillInitialQueue();
     }
 
-    startingQueueSize_ = (int)q_.size();
+    startingQueueSize_ = queued_;
     peakQueue_ = startingQueueSize_;
     peakServers_ = (int)servers_.size();
 
@@ -50,22 +62,94 @@ LoadBalancer::LoadBalancer(const Config& cfg,
     logger_->logLine("New request probability/cycle: " + std::to_string(cfg_.newRequestProb));
     logger_->logLine("Blocked chance percent: " + std::to_string(cfg_.blockedChancePercent));
     logger_->logLine("Checkpoint interval: " + std::to_string(cfg_.logCheckpointInterval));
+    logger_->logLine("Queue capacity: " + (cfg_.queueCapacity > 0 ? std::to_string(cfg_.queueCapacity) : std::string("unbounded")) +
+                     " (shed policy " + std::to_string(cfg_.shedPolicy) + ")");
+    logger_->logLine("Server classes (proc/stream/slots): " + serverClassesText());
+
+    int scaleUpAt = cfg_.maxQueuePerServer * (int)servers_.size();
+    if (cfg_.queueCapacity > 0 && cfg_.queueCapacity <= scaleUpAt) {
+        std::string warning = "[Warning][" + name_ + "] queueCapacity " + std::to_string(cfg_.queueCapacity) +
+                              " <= scale-up threshold " + std::to_string(scaleUpAt) +
+                              ": queue length alone cannot trigger scale-up, shedding will";
+        std::cout << ConsoleColor::wrap(cfg_.useColor, ConsoleColor::YELLOW, warning) << "\n";
+        logger_->logLine(warning);
+    }
+    logger_->logLine("Priority classes: " + std::to_string(cfg_.numPriorityClasses) +
+                     (cfg_.schedPolicy == SCHED_DRR ? " (deficit round robin)" : " (strict)"));
+
+    if (cfg_.metricsFormat != 0) {
+        std::string ext = (cfg_.metricsFormat == MetricsRecorder::FORMAT_OPENMETRICS) ? ".om" : ".csv";
+        metrics_.reset(new MetricsRecorder(cfg_.metricsDir + "/metrics_" + name_ + ext, name_,
+                                           cfg_.metricsFormat, cfg_.metricsBufferSize,
+                                           cfg_.metricsCycleMs));
+        if (metrics_->ok()) {
+            logger_->logLine("Metrics: " + metrics_->path() + " every " +
+                             std::to_string(cfg_.metricsWindow) + " cycles");
+        } else {
+            std::string error = "[Metrics][" + name_ + "] cannot open " + metrics_->path() +
+                                ", export disabled";
+            std::cout << ConsoleColor::wrap(cfg_.useColor, ConsoleColor::RED, error) << "\n";
+            logger_->logLine(error);
+            metrics_.reset();
+        }
+    }
 }
 
 // -------------------- private helpers --------------------
 
 void LoadBalancer::initServers() {
+    std::vector<double> procSpeeds, streamSpeeds;
+    for (const ServerClass& sc : cfg_.serverClasses) {
+        procSpeeds.push_back(sc.procSpeed);
+        streamSpeeds.push_back(sc.streamSpeed);
+    }
+    if (procSpeeds.empty()) {
+        procSpeeds.push_back(1.0);
+        streamSpeeds.push_back(1.0);
+    }
+
     servers_.clear();
+    idleByProc_.reset(procSpeeds);
+    openByStream_.reset(streamSpeeds);
+    idleByProc_.reserve(cfg_.numServers * 2);
+    openByStream_.reserve(cfg_.numServers * 2);
     servers_.reserve(cfg_.numServers);
     for (int i = 0; i < cfg_.numServers; i++) {
-        servers_.emplace_back(i);
+        servers_.push_back(makeServer(i));
+        reindexServer(i);
     }
 }
 
+WebServer LoadBalancer::makeServer(int id) const {
+    if (cfg_.serverClasses.empty()) return WebServer(id);
+
+    const ServerClass& sc = cfg_.serverClasses[id % cfg_.serverClasses.size()];
+    return WebServer(id, sc.procSpeed, sc.streamSpeed, sc.slots);
+}
+
+void LoadBalancer::reindexServer(int idx) {
+    const WebServer& s = servers_[idx];
+
+    LB_ALLOC_SITE(SITE_SERVER_INDEX);
+    idleByProc_.set(idx, s.canAccept('P'));
+    openByStream_.set(idx, s.canAccept('S'));
+}
+
+int LoadBalancer::pickServer(const Request& r) const {
+    return (r.job_type == 'S') ? openByStream_.first() : idleByProc_.first();
+}
+
+int LoadBalancer::serviceCycles(const Request& r, const WebServer& s) const {
+    double factor = (r.job_type == 'S') ? cfg_.streamCostFactor : cfg_.procCostFactor;
+    int cycles = (int)std::ceil(r.time_required * factor / s.speedFor(r.job_type));
+    return cycles < 1 ? 1 : cycles;
+}
+
 void LoadBalancer::fillInitialQueue() {
     int initialCount = cfg_.numServers * cfg_.initialQueueMultiplier;
+    if (cfg_.queueCapacity > 0) initialCount = std::min(initialCount, cfg_.queueCapacity);
     for (int i = 0; i < initialCount; i++) {
-        q_.push(factory_.makeRequest());
+        enqueue(factory_.makeRequest());
     }
 }
 
@@ -89,45 +173,263 @@ bool LoadBalancer::isBlockedIP(const std::string& ip) const {
     return false;
 }
 
+// -------------------- priority queues --------------------
+
+// evicted entries stay in their deque with this time_required until they reach the front
+static const int TOMBSTONE = -1;
+
+// max-heap order: longest job first, oldest first among equals
+static bool longerLast(const std::pair<int, long long>& a, const std::pair<int, long long>& b) {
+    return a.first < b.first || (a.first == b.first && a.second > b.second);
+}
+
+void LoadBalancer::enqueue(const Request& r) {
+    int cls = std::min(std::max(r.priority, 0), cfg_.numPriorityClasses - 1);
+
+    LB_ALLOC_SITE(SITE_QUEUE);
+    long long seq = headSeq_[cls] + (long long)queues_[cls].size();
+    queues_[cls].push_back(r);
+    queues_[cls].back().priority = cls;
+    queues_[cls].back().arrival_time = currentTime_;
+    nonEmpty_ |= (1u << cls);
+    live_[cls]++;
+    queued_++;
+    classStats_[cls].enqueued++;
+
+    if (trackLongest_) {
+        std::vector<std::pair<int, long long>>& heap = longest_[cls];
+        if ((int)heap.size() > 2 * live_[cls] + 64) rebuildLongest(cls);
+        heap.push_back({r.time_required, seq});
+        std::push_heap(heap.begin(), heap.end(), longerLast);
+    }
+}
+
+void LoadBalancer::dropFront(int cls) {
+    queues_[cls].pop_front();
+    headSeq_[cls]++;
+    live_[cls]--;
+    queued_--;
+    settleFront(cls);
+}
+
+void LoadBalancer::evict(int cls, long long seq) {
+    queues_[cls][seq - headSeq_[cls]].time_required = TOMBSTONE;
+    live_[cls]--;
+    queued_--;
+    settleFront(cls);
+}
+
+// keeps front() live for dispatch and DRR
+void LoadBalancer::settleFront(int cls) {
+    std::deque<Request>& q = queues_[cls];
+    while (!q.empty() && q.front().time_required == TOMBSTONE) {
+        q.pop_front();
+        headSeq_[cls]++;
+    }
+    if (q.empty()) {
+        nonEmpty_ &= ~(1u << cls);
+        deficit_[cls] = 0;
+    }
+}
+
+long long LoadBalancer::longestQueued(int cls) {
+    std::vector<std::pair<int, long long>>& heap = longest_[cls];
+    for (;;) {
+        long long seq = heap.front().second;
+        // already dispatched or evicted: discard and look again
+        if (seq >= headSeq_[cls] && queues_[cls][seq - headSeq_[cls]].time_required != TOMBSTONE) {
+            return seq;
+        }
+        std::pop_heap(heap.begin(), heap.end(), longerLast);
+        heap.pop_back();
+    }
+}
+
+// drop stale entries so the heap stays O(live) (reuses its storage)
+void LoadBalancer::rebuildLongest(int cls) {
+    std::vector<std::pair<int, long long>>& heap = longest_[cls];
+    const std::deque<Request>& q = queues_[cls];
+    heap.clear();
+    for (int i = 0; i < (int)q.size(); i++) {
+        if (q[i].time_required != TOMBSTONE) heap.push_back({q[i].time_required, headSeq_[cls] + i});
+    }
+    std::make_heap(heap.begin(), heap.end(), longerLast);
+}
+
+int LoadBalancer::lowestNonEmptyClass() const {
+    return 31 - __builtin_clz(nonEmpty_);
+}
+
+// first non-empty class at or after `from`, wrapping around
+int LoadBalancer::nextNonEmptyClass(int from) const {
+    uint32_t ahead = nonEmpty_ & (~0u << from);
+    return __builtin_ctz(ahead ? ahead : nonEmpty_);
+}
+
+// caller guarantees queued_ > 0
+int LoadBalancer::pickClass() {
+    if (cfg_.schedPolicy == SCHED_STRICT) {
+        return __builtin_ctz(nonEmpty_);
+    }
+
+    // deficit round robin: each visit grants weight * quantum of work (time_required)
+    for (;;) {
+        int cls = nextNonEmptyClass(drrCursor_);
+        if (cls != drrCursor_) {
+            drrCursor_ = cls;
+            drrFresh_ = true;
+        }
+
+        if (drrFresh_) {
+            int weight = cls < (int)cfg_.classWeights.size()
+                             ? cfg_.classWeights[cls]
+                             : cfg_.numPriorityClasses - cls;
+            int quantum = cfg_.drrQuantum > 0 ? cfg_.drrQuantum : cfg_.taskTimeMax;
+            deficit_[cls] += (long long)weight * quantum;
+            drrFresh_ = false;
+        }
+
+        if (queues_[cls].front().time_required <= deficit_[cls]) return cls;
+
+        drrCursor_ = (cls + 1) % cfg_.numPriorityClasses;
+        drrFresh_ = true;
+    }
+}
+
+Request LoadBalancer::popClass(int cls) {
+    Request r = queues_[cls].front();
+    deficit_[cls] -= r.time_required;
+    dropFront(cls);
+
+    ClassStats& st = classStats_[cls];
+    int wait = currentTime_ - r.arrival_time;
+    st.dispatched++;
+    st.totalWait += wait;
+    if (wait > st.maxWait) st.maxWait = wait;
+    return r;
+}
+
+// -------------------- admission control --------------------
+
+void LoadBalancer::noteShed(const std::string& reason, long long& counter, int cls) {
+    counter++;
+    classStats_[cls].shed++;
+    long long total = shed();
+
+    LB_ALLOC_SITE(SITE_LOG_MESSAGE);
+    if (cfg_.logVerboseDrops && (total % 50 == 0)) {
+        std::cout << ConsoleColor::wrap(
+            cfg_.useColor,
+            ConsoleColor::RED,
+            "[Shed][" + name_ + "] time=" + std::to_string(currentTime_) +
+            " reason=" + reason +
+            " total_shed=" + std::to_string(total)
+        ) << "\n";
+    }
+
+    if (logger_ && cfg_.logVerboseDrops && (total % 50 == 0)) {
+        logger_->logLine("[Shed][" + name_ + "] time=" + std::to_string(currentTime_) +
+                         " reason=" + reason +
+                         " total_shed=" + std::to_string(total));
+    }
+}
+
+bool LoadBalancer::makeRoomFor(const Request& r) {
+    if (cfg_.queueCapacity <= 0) return true; // unbounded
+
+    int size = queued_;
+    int arrivalCls = std::min(std::max(r.priority, 0), cfg_.numPriorityClasses - 1);
+
+    // early drop: chance rises linearly from 0 at earlyDropMinFill to 1 at capacity
+    if (cfg_.shedPolicy == SHED_EARLY_DROP && size < cfg_.queueCapacity) {
+        double start = cfg_.earlyDropMinFill * cfg_.queueCapacity;
+        if (size > start) {
+            if (factory_.chance((size - start) / (cfg_.queueCapacity - start))) {
+                noteShed("early", shedEarly_, arrivalCls);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    if (size < cfg_.queueCapacity) return true;
+
+    // evictions only come from the lowest-priority class that has work queued;
+    // an arrival of even lower priority is refused instead
+    int victimCls = lowestNonEmptyClass();
+    bool evicting = cfg_.shedPolicy == SHED_DROP_OLDEST || cfg_.shedPolicy == SHED_DROP_LONGEST;
+
+    // nothing queued ranks below the arrival: plain refusal, whatever the policy
+    if (evicting && arrivalCls > victimCls) {
+        noteShed("full", shedRejected_, arrivalCls);
+        return false;
+    }
+
+    if (cfg_.shedPolicy == SHED_DROP_OLDEST) {
+        noteShed("oldest", shedOldest_, victimCls);
+        dropFront(victimCls);
+        return true;
+    }
+
+    if (cfg_.shedPolicy == SHED_DROP_LONGEST) {
+        long long seq = longestQueued(victimCls);
+        int longestTime = queues_[victimCls][seq - headSeq_[victimCls]].time_required;
+
+        // the arrival itself is the longest job: refuse it instead of evicting
+        if (arrivalCls == victimCls && r.time_required >= longestTime) {
+            noteShed("longest", shedLongest_, arrivalCls);
+            return false;
+        }
+        noteShed("longest", shedLongest_, victimCls);
+        evict(victimCls, seq);
+        return true;
+    }
+
+    noteShed("full", shedRejected_, arrivalCls);
+    return false;
+}
+
 void LoadBalancer::maybeGenerateRandomRequest() {
-    static std::mt19937 rng(std::random_device{}());
-    std::bernoulli_distribution coin(cfg_.newRequestProb);
+    int arrivals = factory_.arrivalsAt(currentTime_);
 
-    if (coin(rng)) {
+    for (int i = 0; i < arrivals; i++) {
         addRequest(factory_.makeRequest());  // firewall handled inside addRequest
         generatedRandom_++;
     }
 }
 
 void LoadBalancer::tickServers() {
-    for (auto& s : servers_) {
-        bool wasBusy = !s.isIdle();
-        s.tick();
-        bool nowIdle = s.isIdle();
-
-        // finished a request this tick
-        if (wasBusy && nowIdle) {
-            processed_++;
+    busyServers_ = 0;
+    for (int i = 0; i < (int)servers_.size(); i++) {
+        int finished = servers_[i].tick();
+        if (!servers_[i].isIdle()) busyServers_++;
+
+        // finished request(s) this tick free capacity
+        if (finished > 0) {
+            processed_ += finished;
+            reindexServer(i);
         }
     }
 }
 
 void LoadBalancer::addServer() {
     int newId = (int)servers_.size();
-    servers_.emplace_back(newId);
+    servers_.push_back(makeServer(newId));
+    reindexServer(newId);
     serversAdded_++;
 
+    LB_ALLOC_SITE(SITE_LOG_MESSAGE);
     std::cout << ConsoleColor::wrap(
         cfg_.useColor,
         ConsoleColor::GREEN,
         "[Scale Up][" + name_ + "] time=" + std::to_string(currentTime_) +
-        " queue=" + std::to_string((int)q_.size()) +
+        " queue=" + std::to_string(queued_) +
         " servers=" + std::to_string((int)servers_.size())
     ) << "\n";
 
     if (logger_) {
         logger_->logLine("[Scale Up][" + name_ + "] time=" + std::to_string(currentTime_) +
-                         " queue=" + std::to_string((int)q_.size()) +
+                         " queue=" + std::to_string(queued_) +
                          " servers=" + std::to_string((int)servers_.size()));
     }
 }
@@ -138,30 +440,37 @@ void LoadBalancer::removeServerIfPossible() {
     WebServer& last = servers_.back();
     if (!last.isIdle()) return; // never remove busy server
 
+    int idx = (int)servers_.size() - 1;
+    idleByProc_.set(idx, false);
+    openByStream_.set(idx, false);
     servers_.pop_back();
     serversRemoved_++;
 
+    LB_ALLOC_SITE(SITE_LOG_MESSAGE);
     std::cout << ConsoleColor::wrap(
         cfg_.useColor,
         ConsoleColor::YELLOW,
         "[Scale Down][" + name_ + "] time=" + std::to_string(currentTime_) +
-        " queue=" + std::to_string((int)q_.size()) +
+        " queue=" + std::to_string(queued_) +
         " servers=" + std::to_string((int)servers_.size())
     ) << "\n";
 
     if (logger_) {
         logger_->logLine("[Scale Down][" + name_ + "] time=" + std::to_string(currentTime_) +
-                         " queue=" + std::to_string((int)q_.size()) +
+                         " queue=" + std::to_string(queued_) +
                          " servers=" + std::to_string((int)servers_.size()));
     }
 }
 
 // -------------------- UML public methods --------------------
 
-void LoadBalancer::addRequest(const Request& r) {
+bool LoadBalancer::addRequest(const Request& r) {
+    arrivals_++;
+
     // firewall / DOS prevention
     if (isBlockedIP(r.ip_in)) {
         dropped_++;
+        LB_ALLOC_SITE(SITE_LOG_MESSAGE);
 
         // Console: show occasionally
         if (cfg_.logVerboseDrops && (dropped_ % 50 == 0)) {
@@ -178,10 +487,14 @@ void LoadBalancer::addRequest(const Request& r) {
             logger_->logLine("[Dropped][" + name_ + "] time=" + std::to_string(currentTime_) +
                              " total_dropped=" + std::to_string(dropped_));
         }
-        return;
+        return false;
     }
 
-    q_.push(r);
+    // admission control (bounded queue)
+    if (!makeRoomFor(r)) return false;
+
+    enqueue(r);
+    return true;
 }
 
 void LoadBalancer::dispatch() {
@@ -189,46 +502,64 @@ void LoadBalancer::dispatch() {
 
     // 1) new request(s) arriving randomly this cycle (if enabled)
     if (internalArrivals_) {
+        LB_ALLOC_PHASE(PHASE_ARRIVALS);
         maybeGenerateRandomRequest();
     }
 
-    // 2) assign queued requests to idle servers
-    for (auto& s : servers_) {
-        if (q_.empty()) break;
-        if (s.isIdle()) {
-            Request r = q_.front();
-            q_.pop();
-            s.assign(r);
+    // 2) assign queued requests to the fastest server that can take them;
+    //    stop at the first head-of-line request with nowhere to go
+    {
+        LB_ALLOC_PHASE(PHASE_DISPATCH);
+        while (queued_ > 0) {
+            int cls = pickClass();
+            int idx = pickServer(queues_[cls].front());
+            if (idx < 0) break;
+
+            Request r = popClass(cls);
+            servers_[idx].assign(r, serviceCycles(r, servers_[idx]));
+            reindexServer(idx);
         }
     }
 
     // 3) process one clock cycle on each server
-    tickServers();
+    {
+        LB_ALLOC_PHASE(PHASE_SERVICE);
+        tickServers();
+    }
 
     // update peak queue size after all actions this cycle
-    if ((int)q_.size() > peakQueue_) peakQueue_ = (int)q_.size();
+    if (queued_ > peakQueue_) peakQueue_ = queued_;
+
+    if (metrics_ && currentTime_ % cfg_.metricsWindow == 0) {
+        LB_ALLOC_PHASE(PHASE_STATS);
+        recordMetrics();
+    }
 
     // 4) checkpoint logging to make the log longer & more useful
     if (logger_ && cfg_.logCheckpointInterval > 0 &&
         (currentTime_ % cfg_.logCheckpointInterval == 0)) {
 
+        LB_ALLOC_PHASE(PHASE_LOGGING);
+        LB_ALLOC_SITE(SITE_LOG_MESSAGE);
         int busy = 0, idle = 0;
         countServerStates(servers_, busy, idle);
 
         logger_->logLine("[Checkpoint][" + name_ + "] time=" + std::to_string(currentTime_) +
-                         " queue=" + std::to_string((int)q_.size()) +
+                         " queue=" + std::to_string(queued_) +
                          " servers=" + std::to_string((int)servers_.size()) +
                          " busy=" + std::to_string(busy) +
                          " idle=" + std::to_string(idle) +
                          " processed=" + std::to_string(processed_) +
                          " dropped=" + std::to_string(dropped_) +
+                         " shed=" + std::to_string(shed()) +
                          " generated=" + std::to_string(generatedRandom_));
     }
 }
 
 void LoadBalancer::scaleServers() {
+    LB_ALLOC_PHASE(PHASE_SCALING);
     int sCount = (int)servers_.size();
-    int qSize = (int)q_.size();
+    int qSize = queued_;
 
     int lower = cfg_.minQueuePerServer * sCount;
     int upper = cfg_.maxQueuePerServer * sCount;
@@ -238,7 +569,12 @@ void LoadBalancer::scaleServers() {
         return;
     }
 
-    if (qSize > upper) {
+    // a bounded queue may never reach `upper`: requests shed since the last
+    // decision (i.e. over the cooldown window) mean we are short of servers too
+    bool shedding = shed() > shedAtLastScaleCheck_;
+    shedAtLastScaleCheck_ = shed();
+
+    if (qSize > upper || shedding) {
         addServer();
         cooldownRemaining_ = cfg_.scaleCooldownN;
     } else if (qSize < lower) {
@@ -249,8 +585,72 @@ void LoadBalancer::scaleServers() {
     if ((int)servers_.size() > peakServers_) peakServers_ = (int)servers_.size();
 }
 
+// no allocation: fills a stack sample and hands it to the ring buffer
+void LoadBalancer::recordMetrics() {
+    MetricsSample now;
+    now.cycle = currentTime_;
+    now.queue = queued_;
+    now.servers = (int)servers_.size();
+    now.busy = busyServers_;
+    now.idle = now.servers - busyServers_;
+    now.arrivals = arrivals_;
+    now.drops = dropped_ + shed();
+    now.completions = processed_;
+
+    MetricsSample window = now;
+    window.arrivals -= lastSample_.arrivals;
+    window.drops -= lastSample_.drops;
+    window.completions -= lastSample_.completions;
+    lastSample_ = now;
+
+    metrics_->record(window);
+}
+
+void LoadBalancer::logLine(const std::string& line) {
+    if (logger_) logger_->logLine(line);
+}
+
+std::string LoadBalancer::serverClassesText() const {
+    if (cfg_.serverClasses.empty()) return "1/1/1 (uniform)";
+
+    std::string text;
+    for (const ServerClass& sc : cfg_.serverClasses) {
+        if (!text.empty()) text += ", ";
+        text += std::to_string(sc.procSpeed) + "/" + std::to_string(sc.streamSpeed) +
+                "/" + std::to_string(sc.slots);
+    }
+    return text;
+}
+
+double LoadBalancer::averageWait() const {
+    long long wait = 0;
+    long long dispatched = 0;
+    for (const ClassStats& st : classStats_) {
+        wait += st.totalWait;
+        dispatched += st.dispatched;
+    }
+    return dispatched > 0 ? (double)wait / dispatched : 0.0;
+}
+
+std::vector<std::string> LoadBalancer::classSummaryLines() const {
+    std::vector<std::string> lines;
+    for (int c = 0; c < cfg_.numPriorityClasses; c++) {
+        const ClassStats& st = classStats_[c];
+        double avgWait = st.dispatched > 0 ? (double)st.totalWait / st.dispatched : 0.0;
+        lines.push_back("Class " + std::to_string(c) +
+                        ": enqueued=" + std::to_string(st.enqueued) +
+                        " dispatched=" + std::to_string(st.dispatched) +
+                        " shed=" + std::to_string(st.shed) +
+                        " queued=" + std::to_string(live_[c]) +
+                        " avg_wait=" + std::to_string(avgWait) +
+                        " max_wait=" + std::to_string(st.maxWait));
+    }
+    return lines;
+}
+
 void LoadBalancer::generateSummary() {
-    endingQueueSize_ = (int)q_.size();
+    LB_ALLOC_PHASE(PHASE_SUMMARY);
+    endingQueueSize_ = queued_;
 
     int busy = 0, idle = 0;
     countServerStates(servers_, busy, idle);
@@ -263,6 +663,14 @@ void LoadBalancer::generateSummary() {
     std::cout << "Random requests generated: " << generatedRandom_ << "\n";
     std::cout << "Processed requests: " << processed_ << "\n";
     std::cout << "Dropped (firewall) requests: " << dropped_ << "\n";
+    std::cout << "Queue capacity: " << (cfg_.queueCapacity > 0 ? std::to_string(cfg_.queueCapacity) : "unbounded") << "\n";
+    std::cout << "Shed (queue full, rejected): " << shedRejected_ << "\n";
+    std::cout << "Shed (drop-oldest): " << shedOldest_ << "\n";
+    std::cout << "Shed (drop-longest): " << shedLongest_ << "\n";
+    std::cout << "Shed (early drop): " << shedEarly_ << "\n";
+    for (const std::string& line : classSummaryLines()) {
+        std::cout << line << "\n";
+    }
     std::cout << "Servers added: " << serversAdded_ << "\n";
     std::cout << "Servers removed: " << serversRemoved_ << "\n";
     std::cout << "Peak servers: " << peakServers_ << "\n";
@@ -270,6 +678,16 @@ void LoadBalancer::generateSummary() {
     std::cout << "Final servers: " << (int)servers_.size() << "\n";
     std::cout << "Busy servers: " << busy << "\n";
     std::cout << "Idle servers: " << idle << "\n";
+
+    std::string metricsLine;
+    if (metrics_) {
+        metrics_->close();
+        metricsLine = "Metrics samples written: " + std::to_string(metrics_->written()) +
+                      " to " + metrics_->path() +
+                      " (overruns: " + std::to_string(metrics_->overruns()) + ")" +
+                      (metrics_->ok() ? "" : " [write errors, file incomplete]");
+        std::cout << metricsLine << "\n";
+    }
     std::cout << "=============\n\n";
 
     // log summary (file)
@@ -282,6 +700,14 @@ void LoadBalancer::generateSummary() {
         logger_->logLine("Random requests generated: " + std::to_string(generatedRandom_));
         logger_->logLine("Processed requests: " + std::to_string(processed_));
         logger_->logLine("Dropped (firewall) requests: " + std::to_string(dropped_));
+        logger_->logLine("Queue capacity: " + (cfg_.queueCapacity > 0 ? std::to_string(cfg_.queueCapacity) : std::string("unbounded")));
+        logger_->logLine("Shed (queue full, rejected): " + std::to_string(shedRejected_));
+        logger_->logLine("Shed (drop-oldest): " + std::to_string(shedOldest_));
+        logger_->logLine("Shed (drop-longest): " + std::to_string(shedLongest_));
+        logger_->logLine("Shed (early drop): " + std::to_string(shedEarly_));
+        for (const std::string& line : classSummaryLines()) {
+            logger_->logLine(line);
+        }
         logger_->logLine("Servers added: " + std::to_string(serversAdded_));
         logger_->logLine("Servers removed: " + std::to_string(serversRemoved_));
         logger_->logLine("Peak servers: " + std::to_string(peakServers_));
@@ -289,6 +715,7 @@ void LoadBalancer::generateSummary() {
         logger_->logLine("Final servers: " + std::to_string((int)servers_.size()));
         logger_->logLine("Busy servers: " + std::to_string(busy));
         logger_->logLine("Idle servers: " + std::to_string(idle));
+        if (!metricsLine.empty()) logger_->logLine(metricsLine);
         logger_->logLine("=== Load Balancer Log End (" + name_ + ") ===");
     }
 
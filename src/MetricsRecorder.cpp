@@ -0,0 +1,306 @@
+#include "MetricsRecorder.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include "AllocProfiler.h"
+
+namespace {
+    const char* FAMILY_NAMES[MetricsRecorder::FAMILY_COUNT] = {
+        "lb_queue_size", "lb_servers", "lb_servers_busy", "lb_servers_idle",
+        "lb_window_arrivals", "lb_window_drops", "lb_window_completions",
+        "lb_metrics_dropped"
+    };
+    const char* FAMILY_HELP[MetricsRecorder::FAMILY_COUNT] = {
+        "Queued requests at the end of the window.",
+        "Servers in the pool.",
+        "Servers processing at least one request.",
+        "Servers with nothing to process.",
+        "Requests offered during the window.",
+        "Requests dropped (firewall or shed) during the window.",
+        "Requests finished during the window.",
+        "Metrics samples lost because the export ring was full."
+    };
+    const int DROPPED_FAMILY = MetricsRecorder::GAUGE_COUNT;
+
+    // how long record() yields to the writer on a full ring before dropping
+    const std::chrono::milliseconds FULL_RING_WAIT(10);
+
+    // room for a value, a timestamp or a gap comment beyond a line's fixed text
+    const std::size_t LINE_SLACK = 64;
+}
+
+MetricsRecorder::MetricsRecorder(const std::string& path, const std::string& lbName,
+                                 int format, int capacity, int cycleMs)
+    : path_(path),
+      lbName_(lbName),
+      format_(format),
+      startMs_(std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::system_clock::now().time_since_epoch()).count()),
+      cycleMs_(cycleMs < 1 ? 1 : cycleMs),
+      ring_(capacity < 2 ? 2 : capacity),
+      wakeAt_(std::max<uint64_t>(1, ring_.size() / 4)) {
+    bool opened;
+    if (format_ == FORMAT_OPENMETRICS) {
+        std::string label = "{lb=\"" + lbName + "\"} ";
+        for (int f = 0; f < FAMILY_COUNT; f++) {
+            prefix_[f] = std::string(FAMILY_NAMES[f]) + (f == DROPPED_FAMILY ? "_total" : "") + label;
+            lineMax_ = std::max(lineMax_, prefix_[f].size() + LINE_SLACK);
+        }
+
+        opened = true;
+        for (int f = 0; f < FAMILY_COUNT && opened; f++) {
+            parts_[f].open(partPath(f), std::ios::trunc);
+            opened = parts_[f].is_open();
+        }
+        // don't leave the families that did open behind
+        if (!opened) {
+            for (int f = 0; f < FAMILY_COUNT; f++) {
+                if (!parts_[f].is_open()) continue;
+                parts_[f].close();
+                std::remove(partPath(f).c_str());
+            }
+        }
+    } else {
+        // a gap comment and the sample row
+        lineMax_ = lbName_.size() + 8 * 21 + 2 * LINE_SLACK;
+        out_.open(path_, std::ios::trunc);
+        opened = out_.is_open();
+        out_ << "lb,cycle,queue,servers,busy,idle,arrivals,drops,completions\n";
+    }
+
+    // caller reports the error; no writer means record() only counts overruns
+    if (!opened) {
+        failed_ = true;
+        return;
+    }
+    writer_ = std::thread(&MetricsRecorder::writerLoop, this);
+}
+
+MetricsRecorder::~MetricsRecorder() {
+    close();
+}
+
+// notify under the mutex the writer checks its predicate with, so the
+// wakeup cannot fall between that check and the wait
+void MetricsRecorder::wakeWriter() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    wake_.notify_one();
+}
+
+void MetricsRecorder::record(const MetricsSample& s) {
+    if (failed_.load(std::memory_order_relaxed) && !writer_.joinable()) return;
+
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    uint64_t tail = tail_.load(std::memory_order_acquire);
+    uint64_t cap = ring_.size();
+
+    if (head - tail == cap) {
+        // the writer may share a core with the simulation: hand it the CPU
+        // before giving up on the sample (once per gap, not per dropped sample)
+        if (pendingGap_ == 0) {
+            wakeWriter();
+            auto deadline = std::chrono::steady_clock::now() + FULL_RING_WAIT;
+            while (head - tail == cap && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::yield();
+                tail = tail_.load(std::memory_order_acquire);
+            }
+        }
+        if (head - tail == cap) {
+            overruns_++;
+            pendingGap_++;
+            lastDroppedCycle_ = s.cycle;
+            return;
+        }
+    }
+
+    MetricsSample& slot = ring_[head % cap];
+    slot = s;
+    slot.gapBefore = pendingGap_;
+    pendingGap_ = 0;
+    head_.store(head + 1, std::memory_order_release);
+
+    if (head + 1 - tail == wakeAt_) wakeWriter();
+}
+
+void MetricsRecorder::close() {
+    if (!writer_.joinable()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+        wake_.notify_one();
+    }
+    writer_.join();
+
+    // samples dropped after the last one that made it into the ring
+    if (pendingGap_ > 0) {
+        startBuffers(1);
+        writeGap(pendingGap_, lastDroppedCycle_, true);
+        pendingGap_ = 0;
+        if (!flushBuffers()) failed_ = true;
+    }
+
+    if (format_ == FORMAT_OPENMETRICS) finishOpenMetrics();
+    else out_.flush();
+}
+
+std::string MetricsRecorder::partPath(int family) const {
+    return path_ + "." + FAMILY_NAMES[family] + ".part";
+}
+
+// headers, then each family's spilled lines as one contiguous block
+void MetricsRecorder::finishOpenMetrics() {
+    std::ofstream out(path_, std::ios::trunc);
+    std::vector<char> chunk(1 << 20); // large block copies; the parts can be hundreds of MB
+    for (int f = 0; f < FAMILY_COUNT; f++) {
+        parts_[f].close();
+        out << "# HELP " << FAMILY_NAMES[f] << " " << FAMILY_HELP[f] << "\n"
+            << "# TYPE " << FAMILY_NAMES[f] << (f == DROPPED_FAMILY ? " counter\n" : " gauge\n");
+
+        std::ifstream part(partPath(f), std::ios::binary);
+        while (part.read(chunk.data(), (std::streamsize)chunk.size()) || part.gcount() > 0) {
+            out.write(chunk.data(), part.gcount());
+        }
+        part.close();
+        std::remove(partPath(f).c_str());
+    }
+    out << "# EOF\n";
+    out.flush();
+    if (!out) failed_ = true;
+}
+
+void MetricsRecorder::writerLoop() {
+    LB_ALLOC_PHASE(PHASE_STATS);
+
+    while (!stop_) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait_for(lock, std::chrono::milliseconds(100), [&] {
+                return stop_ || head_.load(std::memory_order_acquire) -
+                                tail_.load(std::memory_order_relaxed) >= wakeAt_;
+            });
+        }
+        drain();
+    }
+    drain();
+}
+
+void MetricsRecorder::drain() {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    uint64_t head = head_.load(std::memory_order_acquire);
+    if (head == tail) return;
+
+    startBuffers(head - tail);
+    for (uint64_t i = tail; i < head; i++) {
+        const MetricsSample& s = ring_[i % ring_.size()];
+        if (s.gapBefore > 0) writeGap(s.gapBefore, s.cycle, false);
+        writeSample(s);
+    }
+    tail_.store(head, std::memory_order_release);
+
+    // only count samples that actually reached the disk
+    if (flushBuffers()) written_ += (long long)(head - tail);
+    else failed_ = true;
+}
+
+// size every buffer for `samples` worst-case lines up front, so formatting is
+// plain pointer writes (buffers only grow at a new drain high-water mark)
+void MetricsRecorder::startBuffers(std::size_t samples) {
+    int buffers = format_ == FORMAT_OPENMETRICS ? FAMILY_COUNT : 1;
+    for (int f = 0; f < buffers; f++) {
+        if (buf_[f].size() < samples * lineMax_) buf_[f].resize(samples * lineMax_);
+        pos_[f] = buf_[f].data();
+    }
+}
+
+bool MetricsRecorder::flushBuffers() {
+    if (format_ != FORMAT_OPENMETRICS) {
+        out_.write(buf_[0].data(), (std::streamsize)(pos_[0] - buf_[0].data()));
+        out_.flush();
+        return (bool)out_;
+    }
+
+    bool good = true;
+    for (int f = 0; f < FAMILY_COUNT; f++) {
+        std::streamsize len = (std::streamsize)(pos_[f] - buf_[f].data());
+        if (len == 0) continue;
+        parts_[f].write(buf_[f].data(), len);
+        parts_[f].flush();
+        good = good && (bool)parts_[f];
+    }
+    return good;
+}
+
+// writer-thread formatting into buffers startBuffers() sized
+static char* putText(char* p, const char* text, std::size_t len) {
+    std::memcpy(p, text, len);
+    return p + len;
+}
+
+static char* putNumber(char* p, long long v) {
+    return std::to_chars(p, p + 24, v).ptr;
+}
+
+// " <seconds>.<millis>\n": OpenMetrics timestamps are seconds since the epoch
+static int formatTimestamp(char* out, long long ms) {
+    char* p = out;
+    *p++ = ' ';
+    p = putNumber(p, ms / 1000);
+    long long frac = ms % 1000;
+    *p++ = '.';
+    *p++ = (char)('0' + frac / 100);
+    *p++ = (char)('0' + frac / 10 % 10);
+    *p++ = (char)('0' + frac % 10);
+    *p++ = '\n';
+    return (int)(p - out);
+}
+
+void MetricsRecorder::writeSample(const MetricsSample& s) {
+    if (format_ == FORMAT_OPENMETRICS) {
+        const long long values[GAUGE_COUNT] = {s.queue, s.servers, s.busy, s.idle,
+                                               s.arrivals, s.drops, s.completions};
+        // the timestamp is shared by every family, format it once
+        char ts[40];
+        int tsLen = formatTimestamp(ts, startMs_ + s.cycle * cycleMs_);
+        for (int f = 0; f < GAUGE_COUNT; f++) {
+            char* p = putText(pos_[f], prefix_[f].data(), prefix_[f].size());
+            p = putNumber(p, values[f]);
+            pos_[f] = putText(p, ts, tsLen);
+        }
+    } else {
+        char* p = putText(pos_[0], lbName_.data(), lbName_.size());
+        const long long values[] = {s.cycle, s.queue, s.servers, s.busy, s.idle,
+                                    s.arrivals, s.drops, s.completions};
+        for (long long v : values) {
+            *p++ = ',';
+            p = putNumber(p, v);
+        }
+        *p++ = '\n';
+        pos_[0] = p;
+    }
+}
+
+// gap marker: dropped samples ended before `cycle` (or, trailing, at `cycle`)
+void MetricsRecorder::writeGap(long long dropped, long long cycle, bool trailing) {
+    if (format_ == FORMAT_OPENMETRICS) {
+        droppedTotal_ += dropped;
+        char ts[40];
+        int tsLen = formatTimestamp(ts, startMs_ + cycle * cycleMs_);
+        char* p = putText(pos_[DROPPED_FAMILY], prefix_[DROPPED_FAMILY].data(),
+                          prefix_[DROPPED_FAMILY].size());
+        p = putNumber(p, droppedTotal_);
+        pos_[DROPPED_FAMILY] = putText(p, ts, tsLen);
+    } else {
+        static const char GAP[] = "# gap: ";
+        static const char BEFORE[] = " samples dropped before cycle ";
+        static const char THROUGH[] = " samples dropped through cycle ";
+        char* p = putText(pos_[0], GAP, sizeof(GAP) - 1);
+        p = putNumber(p, dropped);
+        p = trailing ? putText(p, THROUGH, sizeof(THROUGH) - 1) : putText(p, BEFORE, sizeof(BEFORE) - 1);
+        p = putNumber(p, cycle);
+        *p++ = '\n';
+        pos_[0] = p;
+    }
+}
@@ -0,0 +1,186 @@
+#include "QueueEstimator.h"
+#include <algorithm>
+#include <cmath>
+#include "RequestFactory.h"
+
+// share of 'S' jobs produced by RequestFactory
+static const double STREAM_SHARE = 0.5;
+
+// P(task time <= x) for the configured model, before RequestFactory's ceil/clamp
+static double taskTimeCdf(const Config& cfg, double x) {
+    if (cfg.taskTimeModel == TASK_PARETO) {
+        if (x < cfg.taskTimeMin) return 0.0;
+        return 1.0 - std::pow(cfg.taskTimeMin / x, cfg.taskTimeShape);
+    }
+    if (cfg.taskTimeModel == TASK_LOGNORMAL) {
+        if (x <= 0.0) return 0.0;
+        double mu = std::log((cfg.taskTimeMin + cfg.taskTimeMax) / 2.0);
+        return 0.5 * std::erfc(-(std::log(x) - mu) / (cfg.taskTimeShape * std::sqrt(2.0)));
+    }
+    return 0.0; // uniform is handled directly
+}
+
+// probability RequestFactory hands out exactly t cycles
+static double taskTimeWeight(const Config& cfg, int t) {
+    if (cfg.taskTimeModel == TASK_UNIFORM) return t <= cfg.taskTimeMax ? 1.0 : 0.0;
+
+    double upper = t == cfg.taskTimeCap ? 1.0 : taskTimeCdf(cfg, t);
+    double lower = t == cfg.taskTimeMin ? 0.0 : taskTimeCdf(cfg, t - 1);
+    return upper - lower;
+}
+
+QueueEstimator::QueueEstimator(const Config& cfg)
+    : cfg_(cfg) {
+    // Bernoulli(p) per cycle thinned by the firewall is Bernoulli(lambda):
+    // geometric inter-arrival times with SCV 1 - lambda. The other models are
+    // Poisson per cycle (SCV 1); MMPP bursts make the real SCV larger, so its
+    // estimate is optimistic.
+    lambda_ = RequestFactory::meanArrivalRate(cfg_) * (1.0 - cfg_.blockedChancePercent / 100.0);
+    arrivalScv_ = cfg_.arrivalModel == ARRIVAL_BERNOULLI ? 1.0 - lambda_ : 1.0;
+
+    // exact moments of ceil(time * factor / speed) over the task-time
+    // distribution, both job types and every server class
+    std::vector<ServerClass> classes = cfg_.serverClasses;
+    if (classes.empty()) classes.push_back(ServerClass());
+
+    double m1 = 0.0, m2 = 0.0, weight = 0.0;
+    for (int t = cfg_.taskTimeMin; t <= cfg_.taskTimeCap; t++) {
+        double w = taskTimeWeight(cfg_, t);
+        if (w <= 0.0) continue;
+
+        for (const ServerClass& sc : classes) {
+            double p = std::ceil(t * cfg_.procCostFactor / sc.procSpeed);
+            double s = std::ceil(t * cfg_.streamCostFactor / sc.streamSpeed);
+            p = std::max(p, 1.0);
+            s = std::max(s, 1.0);
+
+            m1 += w * ((1.0 - STREAM_SHARE) * p + STREAM_SHARE * s);
+            m2 += w * ((1.0 - STREAM_SHARE) * p * p + STREAM_SHARE * s * s);
+            weight += w;
+        }
+    }
+    meanService_ = m1 / weight;
+    serviceScv_ = (m2 / weight) / (meanService_ * meanService_) - 1.0;
+}
+
+// a server runs one 'P' job or up to `slots` 'S' jobs, so weight it by the job mix
+double QueueEstimator::channelWeight(int serverId) const {
+    if (cfg_.serverClasses.empty()) return 1.0;
+
+    const ServerClass& sc = cfg_.serverClasses[serverId % cfg_.serverClasses.size()];
+    return (1.0 - STREAM_SHARE) + STREAM_SHARE * sc.slots;
+}
+
+double QueueEstimator::channelsFor(int servers) const {
+    double channels = 0.0;
+    for (int i = 0; i < servers; i++) channels += channelWeight(i);
+    return channels;
+}
+
+QueueEstimator::Estimate QueueEstimator::fromErlangB(int servers, double channels, double erlangB) const {
+    Estimate e;
+    e.servers = servers;
+    e.channels = channels;
+    e.arrivalRate = lambda_;
+    e.meanService = meanService_;
+
+    int c = std::max(1, (int)std::lround(channels));
+    double offered = lambda_ * meanService_;
+    e.utilization = offered / c;
+    e.stable = e.utilization < 1.0;
+    e.throughput = e.stable ? lambda_ : c / meanService_;
+
+    if (!e.stable) {
+        e.probWait = 1.0;
+        e.queueLength = INFINITY;
+        e.waitTime = INFINITY;
+        return e;
+    }
+
+    // Erlang-C from Erlang-B, then Allen-Cunneen: Wq ~ C / (c*mu - lambda) * (ca^2 + cs^2) / 2
+    e.probWait = erlangB / (1.0 - e.utilization * (1.0 - erlangB));
+    e.waitTime = e.probWait / (c / meanService_ - lambda_) * (arrivalScv_ + serviceScv_) / 2.0;
+    e.queueLength = lambda_ * e.waitTime;
+    return e;
+}
+
+QueueEstimator::Estimate QueueEstimator::estimate(int servers) const {
+    double channels = channelsFor(servers);
+    int c = std::max(1, (int)std::lround(channels));
+    double offered = lambda_ * meanService_;
+
+    // Erlang-B recursion: B(k) = a B(k-1) / (k + a B(k-1))
+    double b = 1.0;
+    for (int k = 1; k <= c; k++) b = offered * b / (k + offered * b);
+
+    return fromErlangB(servers, channels, b);
+}
+
+QueueEstimator::AutoscalePrediction QueueEstimator::predictAutoscaler() const {
+    // scaleServers() adds a server while queue > max*s and removes one while
+    // queue < min*s. Lq(s) falls as s grows, so the rest states form a band.
+    AutoscalePrediction pred;
+    double offered = lambda_ * meanService_;
+    int limit = (int)std::ceil(offered) * 4 + 100;
+
+    double b = 1.0;
+    int k = 0;
+    double channels = 0.0;
+    int low = -1, high = -1;
+    for (int s = 1; s <= limit; s++) {
+        channels += channelWeight(s - 1);
+
+        // advance the Erlang-B recursion to this server count's channels
+        int c = std::max(1, (int)std::lround(channels));
+        while (k < c) {
+            k++;
+            b = offered * b / (k + offered * b);
+        }
+
+        Estimate e = fromErlangB(s, channels, b);
+        bool scalesUp = !e.stable || e.queueLength > (double)cfg_.maxQueuePerServer * s;
+        bool scalesDown = s > 1 && e.queueLength < (double)cfg_.minQueuePerServer * s;
+
+        if (low < 0 && !scalesUp) low = s;
+        if (!scalesUp && !scalesDown) high = s;
+        if (low >= 0 && scalesDown) break; // every larger s scales down too
+    }
+
+    if (low < 0) low = limit;
+    pred.low = low;
+    pred.oscillates = high < 0;
+    pred.high = pred.oscillates ? low : high;
+
+    if (pred.oscillates) pred.settle = low;
+    else pred.settle = std::min(std::max(cfg_.numServers, pred.low), pred.high);
+    return pred;
+}
+
+std::vector<std::string> QueueEstimator::reportLines(const Estimate& e, const AutoscalePrediction& a) const {
+    std::vector<std::string> lines;
+    lines.push_back("Servers: " + std::to_string(e.servers) +
+                    " (channels " + std::to_string(e.channels) + ")");
+    lines.push_back("Arrival rate (admitted/cycle): " + std::to_string(e.arrivalRate));
+    lines.push_back("Mean service time: " + std::to_string(e.meanService) +
+                    " cycles (SCV " + std::to_string(serviceScv_) + ")");
+    lines.push_back("Utilization: " + std::to_string(e.utilization) +
+                    (e.stable ? "" : " (overloaded, queue grows without bound)"));
+
+    if (e.stable) {
+        lines.push_back("P(wait): " + std::to_string(e.probWait));
+        lines.push_back("Expected queue length: " + std::to_string(e.queueLength));
+        lines.push_back("Expected wait: " + std::to_string(e.waitTime) + " cycles");
+    }
+
+    if (a.oscillates && a.low > 1) {
+        lines.push_back("Autoscaler: oscillates between " + std::to_string(a.low - 1) +
+                        " and " + std::to_string(a.low) + " servers");
+    } else if (a.oscillates) {
+        lines.push_back("Autoscaler: oscillates at 1 server");
+    } else {
+        lines.push_back("Autoscaler rest band: " + std::to_string(a.low) + " to " +
+                        std::to_string(a.high) + " servers, settles at " +
+                        std::to_string(a.settle));
+    }
+    return lines;
+}
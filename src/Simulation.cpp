@@ -1,26 +1,90 @@
 #include "Simulation.h"
 #include <iostream>
+#include "AllocProfiler.h"
 
-Simulation::Simulation(const Config& cfg)
+Simulation::Simulation(const Config& cfg, bool collectStats)
     : currentTime_(0),
       maxTime_(cfg.totalCycles),
       cfg_(cfg),
-      lb_(cfg_, "MAIN", "logs/loadbalancer_log.txt") {}
+      lb_(cfg_, "MAIN", "logs/loadbalancer_log.txt"),
+      steady_(cfg_.ssBatchSize, cfg_.ssMinBatches, cfg_.ssTolerance, cfg_.ssMinCycles),
+      collectStats_(collectStats || cfg.steadyStateMode) {
+    if (collectStats_) steady_.reserve(maxTime_);
+}
 
 void Simulation::runSimulation() {
     std::cout << "\n=== LoadBalancer run start ===\n";
     std::cout << "Servers: " << cfg_.numServers << "\n";
     std::cout << "Total cycles: " << cfg_.totalCycles << "\n";
 
+    long long lastProcessed = lb_.processed();
+
     for (currentTime_ = 0; currentTime_ < maxTime_; currentTime_++) {
+        if (cfg_.allocSteadyStateAfter > 0 && currentTime_ == cfg_.allocSteadyStateAfter) {
+            AllocProfiler::beginSteadyState();
+        }
+
         lb_.dispatch();
         lb_.scaleServers();
 
         if (cfg_.logCheckpointInterval > 0 && (currentTime_ % cfg_.logCheckpointInterval == 0)) {
             std::cout << "Cycle " << currentTime_ << " checkpoint\n";
         }
+
+        // measured for steadyStateMode or validation; only the former stops the run
+        if (!collectStats_) continue;
+
+        long long done = lb_.processed();
+        bool converged;
+        {
+            LB_ALLOC_PHASE(PHASE_STATS);
+            converged = steady_.record(lb_.queueSize(), lb_.serverCount(),
+                                       (double)(done - lastProcessed));
+        }
+        lastProcessed = done;
+
+        if (cfg_.steadyStateMode && converged) {
+            currentTime_++;
+            break;
+        }
+    }
+
+    AllocProfiler::endSteadyState();
+    steady_.finish();
+
+    if (cfg_.steadyStateMode) {
+        std::cout << "\n=== Steady State (MAIN) ===\n";
+        std::string stopLine = "Cycles run: " + std::to_string(currentTime_) + " of " +
+                               std::to_string(maxTime_) +
+                               (currentTime_ < maxTime_ ? " (stopped early)" : "");
+        std::cout << stopLine << "\n";
+        lb_.logLine("=== Steady State (MAIN) ===");
+        lb_.logLine(stopLine);
+
+        for (const std::string& line : steady_.reportLines()) {
+            std::cout << line << "\n";
+            lb_.logLine(line);
+        }
+    }
+
+    // regression guard: the per-cycle path must not touch the heap once warmed up
+    std::string failLine = AllocProfiler::steadyStateFailure(cfg_.allocSteadyStateAfter);
+    if (cfg_.allocFailOnSteadyState && cfg_.allocSteadyStateAfter > 0 && !failLine.empty()) {
+        passed_ = false;
+        std::cout << failLine << "\n";
+        lb_.logLine(failLine);
+    }
+
+    if (AllocProfiler::enabled()) {
+        LB_ALLOC_PHASE(PHASE_SUMMARY);
+        std::cout << "\n=== Allocation Profile ===\n";
+        lb_.logLine("=== Allocation Profile ===");
+        for (const std::string& line : AllocProfiler::reportLines(lb_.processed(), currentTime_)) {
+            std::cout << line << "\n";
+            lb_.logLine(line);
+        }
     }
 
     lb_.generateSummary();
     std::cout << "=== LoadBalancer run end ===\n\n";
-}
\ No newline at end of file
+}
@@ -0,0 +1,215 @@
+#include "SteadyStateDetector.h"
+#include <algorithm>
+#include <cmath>
+
+// two-sided 95% Student t critical values, index = degrees of freedom (1..30)
+static double tCritical95(int df) {
+    static const double table[] = {
+        0.0,
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if (df < 1) return table[1];
+    if (df <= 30) return table[df];
+    return 1.96;
+}
+
+static const char* metricName(int m) {
+    switch (m) {
+        case SteadyStateDetector::QUEUE: return "queue length";
+        case SteadyStateDetector::SERVERS: return "server count";
+        default: return "throughput/cycle";
+    }
+}
+
+// batch means whose lag-1 autocorrelation exceeds this are not independent
+// enough for a t-interval; the batches are merged pairwise until they are
+static const double MAX_LAG1 = 0.2;
+
+SteadyStateDetector::SteadyStateDetector(int batchSize, int minBatches, double tolerance, int minCycles)
+    : batchSize_(batchSize < 1 ? 1 : batchSize),
+      minBatches_(minBatches < 2 ? 2 : minBatches),
+      tolerance_(tolerance),
+      minCycles_(minCycles < 0 ? 0 : minCycles),
+      nextCheck_(minBatches_) {}
+
+void SteadyStateDetector::reserve(int cycles) {
+    for (int m = 0; m < METRIC_COUNT; m++) {
+        base_[m].reserve(cycles / batchSize_ + 1);
+        prefix_[m].reserve(cycles / batchSize_ + 1);
+        prefixSq_[m].reserve(cycles / batchSize_ + 1);
+    }
+}
+
+bool SteadyStateDetector::record(double queue, double servers, double throughput) {
+    batchSum_[QUEUE] += queue;
+    batchSum_[SERVERS] += servers;
+    batchSum_[THROUGHPUT] += throughput;
+    cycles_++;
+
+    if (++inBatch_ == batchSize_) closeBatch();
+    return converged_;
+}
+
+void SteadyStateDetector::finish() {
+    if (baseBatches_ != evaluatedAt_) evaluate();
+}
+
+// MSER: the prefix d (at most half the series) minimising the squared
+// deviation of what remains, scaled by 1 / (n - d)^2
+int SteadyStateDetector::mserTruncation(int metric) const {
+    const std::vector<double>& sum = prefix_[metric];
+    const std::vector<double>& sumSq = prefixSq_[metric];
+    int n = batches_;
+
+    // suffix = total - prefix, so each candidate d is O(1); differences that
+    // are pure rounding count as zero so a constant tail still ties exactly
+    double noise = 1e-12 * sumSq[n];
+    int best = 0;
+    double bestScore = 0.0;
+    for (int d = 0; d <= n / 2; d++) {
+        int m = n - d;
+        double s = sum[n] - sum[d];
+        double ss = (sumSq[n] - sumSq[d]) - s * s / m;
+        if (ss < noise) ss = 0.0;
+        double score = ss / ((double)m * m);
+        if (d == 0 || score < bestScore) {
+            bestScore = score;
+            best = d;
+        }
+    }
+    return best;
+}
+
+// lag-1 autocorrelation of the grouped means from index `from` on (0 for a flat series)
+double SteadyStateDetector::lag1(int metric, int from, double mean) const {
+    const std::vector<double>& sum = prefix_[metric];
+    double num = 0.0;
+    double den = 0.0;
+    double prev = sum[from + 1] - sum[from] - mean;
+    den += prev * prev;
+    for (int i = from + 1; i < batches_; i++) {
+        double x = sum[i + 1] - sum[i] - mean;
+        num += prev * x;
+        den += x * x;
+        prev = x;
+    }
+    if (den <= 1e-12 * (prefixSq_[metric][batches_] + 1.0)) return 0.0;
+    return num / den;
+}
+
+void SteadyStateDetector::closeBatch() {
+    for (int m = 0; m < METRIC_COUNT; m++) {
+        base_[m].push_back(batchSum_[m] / batchSize_);
+        batchSum_[m] = 0.0;
+    }
+    inBatch_ = 0;
+    baseBatches_++;
+
+    // MSER is O(n); spacing checks ~n/16 apart keeps the run linear
+    if (baseBatches_ < nextCheck_) return;
+    nextCheck_ = baseBatches_ + std::max(1, baseBatches_ / 16);
+    evaluate();
+}
+
+void SteadyStateDetector::buildGroups() {
+    batches_ = baseBatches_ / groupSize_;
+    for (int m = 0; m < METRIC_COUNT; m++) {
+        const std::vector<double>& base = base_[m];
+        std::vector<double>& sum = prefix_[m];
+        std::vector<double>& sumSq = prefixSq_[m];
+        sum.resize(batches_ + 1);
+        sumSq.resize(batches_ + 1);
+        sum[0] = 0.0;
+        sumSq[0] = 0.0;
+
+        for (int i = 0; i < batches_; i++) {
+            double g = 0.0;
+            for (int j = i * groupSize_; j < (i + 1) * groupSize_; j++) g += base[j];
+            g /= groupSize_;
+            // shifted by the first mean so sums of squares keep their precision
+            if (i == 0) shift_[m] = g;
+            double x = g - shift_[m];
+            sum[i + 1] = sum[i] + x;
+            sumSq[i + 1] = sumSq[i] + x * x;
+        }
+    }
+}
+
+// warm-up, intervals and convergence for the current grouping; returns
+// false if the retained means are still correlated
+bool SteadyStateDetector::checkGroups() {
+    // discard the longest warm-up any metric asks for
+    warmupBatches_ = 0;
+    for (int m = 0; m < METRIC_COUNT; m++) {
+        warmupBatches_ = std::max(warmupBatches_, mserTruncation(m));
+    }
+
+    converged_ = false;
+    int n = batches_;
+    int w = warmupBatches_;
+    int k = n - w;
+    if (k < 2) return true;
+
+    // a short window can look flat or tight between two scaling steps, so
+    // nothing (a zero-variance metric included) counts until it is long enough
+    bool allTight = k >= minBatches_ && (long long)k * groupSize_ * batchSize_ >= minCycles_;
+    bool independent = true;
+    for (int m = 0; m < METRIC_COUNT; m++) {
+        const std::vector<double>& sum = prefix_[m];
+        const std::vector<double>& sumSq = prefixSq_[m];
+
+        double total = sum[n] - sum[w];
+        double mean = total / k;
+        double var = ((sumSq[n] - sumSq[w]) - total * mean) / (k - 1);
+        if (var < 0.0) var = 0.0; // rounding on near-constant series
+
+        intervals_[m].mean = mean + shift_[m];
+        intervals_[m].halfWidth = tCritical95(k - 1) * std::sqrt(var / k);
+        lag1_[m] = lag1(m, w, mean);
+        if (lag1_[m] > MAX_LAG1) independent = false;
+
+        // tight enough relative to the mean ...
+        if (intervals_[m].halfWidth > tolerance_ * std::fabs(intervals_[m].mean)) allTight = false;
+
+        // ... and no drift between the two halves of the retained run
+        int half = k / 2;
+        double first = (sum[w + half] - sum[w]) / half;
+        double second = (sum[n] - sum[w + half]) / (k - half);
+        // (slack for prefix-sum rounding, which is not zero on a constant series)
+        double slack = 1e-9 * std::max(1.0, std::fabs(intervals_[m].mean));
+        if (std::fabs(second - first) > 2.0 * intervals_[m].halfWidth + slack) allTight = false;
+    }
+
+    converged_ = allTight && independent;
+    return independent;
+}
+
+void SteadyStateDetector::evaluate() {
+    evaluatedAt_ = baseBatches_;
+
+    // grow the batch size while the means are correlated and there are still
+    // enough batches to halve; otherwise wait for more data at this size
+    buildGroups();
+    while (!checkGroups() && batches_ >= 2 * minBatches_) {
+        groupSize_ *= 2;
+        buildGroups();
+    }
+}
+
+std::vector<std::string> SteadyStateDetector::reportLines() const {
+    std::vector<std::string> lines;
+    lines.push_back("Steady state: " + std::string(converged_ ? "converged" : "not converged") +
+                    " after " + std::to_string(cycles_) + " cycles (" +
+                    std::to_string(batches_) + " batches of " + std::to_string(effectiveBatchSize()) + ")");
+    lines.push_back("Warm-up discarded (MSER): " + std::to_string(warmupCycles()) + " cycles");
+
+    for (int m = 0; m < METRIC_COUNT; m++) {
+        lines.push_back("95% CI " + std::string(metricName(m)) + ": " +
+                        std::to_string(intervals_[m].mean) + " +/- " +
+                        std::to_string(intervals_[m].halfWidth) +
+                        " (lag-1 r " + std::to_string(lag1_[m]) + ")");
+    }
+    return lines;
+}
@@ -1,34 +1,41 @@
 #include "Switch.h"
+#include "AllocProfiler.h"
 #include <random>
 #include <iostream>
 
-Switch::Switch(const Config& cfg, LoadBalancer& streamingLB, LoadBalancer& processingLB)
-    : cfg_(cfg), stream_(streamingLB), proc_(processingLB), factory_(cfg) {}
+Switch::Switch(const Config& cfg, LoadBalancer& streamingLB, LoadBalancer& processingLB,
+               bool internalArrivals)
+    : cfg_(cfg), stream_(streamingLB), proc_(processingLB), factory_(cfg, 1),
+      internalArrivals_(internalArrivals) {}
 
-void Switch::route(const Request& r) {
+bool Switch::route(const Request& r) {
     if (r.job_type == 'S') {
-        stream_.addRequest(r);
         routedStream_++;
-    } else {
-        proc_.addRequest(r);
-        routedProc_++;
+        return stream_.addRequest(r);
     }
+    routedProc_++;
+    return proc_.addRequest(r);
 }
 
 void Switch::maybeGenerateAndRoute() {
-    static std::mt19937 rng(std::random_device{}());
-    std::bernoulli_distribution coin(cfg_.newRequestProb);
+    int arrivals = factory_.arrivalsAt(time_);
 
-    if (coin(rng)) {
+    for (int i = 0; i < arrivals; i++) {
         Request r = factory_.makeRequest();   // produces job_type 'S'/'P'
         route(r);
     }
 }
 
 void Switch::step() {
+    if (cfg_.allocSteadyStateAfter > 0 && time_ == cfg_.allocSteadyStateAfter) {
+        AllocProfiler::beginSteadyState();
+    }
     time_++;
 
-    maybeGenerateAndRoute();
+    if (internalArrivals_) {
+        LB_ALLOC_PHASE(PHASE_ARRIVALS);
+        maybeGenerateAndRoute();
+    }
 
     // tick both load balancers each cycle
     stream_.dispatch();
@@ -45,13 +52,40 @@ void Switch::summary() {
     std::cout << "Streaming LB: queue=" << stream_.queueSize()
               << " servers=" << stream_.serverCount()
               << " processed=" << stream_.processed()
-              << " dropped=" << stream_.dropped() << "\n";
+              << " dropped=" << stream_.dropped()
+              << " shed=" << stream_.shed() << "\n";
     std::cout << "Processing LB: queue=" << proc_.queueSize()
               << " servers=" << proc_.serverCount()
               << " processed=" << proc_.processed()
-              << " dropped=" << proc_.dropped() << "\n";
+              << " dropped=" << proc_.dropped()
+              << " shed=" << proc_.shed() << "\n";
     std::cout << "======================\n\n";
 
+    // regression guard: the per-cycle path must not touch the heap once warmed up
+    AllocProfiler::endSteadyState();
+    std::string failLine = AllocProfiler::steadyStateFailure(cfg_.allocSteadyStateAfter);
+    if (cfg_.allocFailOnSteadyState && cfg_.allocSteadyStateAfter > 0 && !failLine.empty()) {
+        passed_ = false;
+        std::cout << failLine << "\n";
+        stream_.logLine(failLine);
+        proc_.logLine(failLine);
+    }
+
+    // process-wide counters: one report against both LBs' work
+    if (AllocProfiler::enabled()) {
+        LB_ALLOC_PHASE(PHASE_SUMMARY);
+        std::cout << "=== Allocation Profile ===\n";
+        stream_.logLine("=== Allocation Profile ===");
+        proc_.logLine("=== Allocation Profile ===");
+        for (const std::string& line :
+             AllocProfiler::reportLines(stream_.processed() + proc_.processed(), time_)) {
+            std::cout << line << "\n";
+            stream_.logLine(line);
+            proc_.logLine(line);
+        }
+        std::cout << "\n";
+    }
+
     stream_.generateSummary();
     proc_.generateSummary();
 }
\ No newline at end of file
@@ -1,27 +1,54 @@
 #include "WebServer.h"
+#include "AllocProfiler.h"
 
-WebServer::WebServer(int id)
-    : id_(id), busy_(false), remaining_(0), current_(std::nullopt) {}
+WebServer::WebServer(int id, double procSpeed, double streamSpeed, int slots)
+    : id_(id),
+      procSpeed_(procSpeed),
+      streamSpeed_(streamSpeed),
+      active_(0),
+      exclusive_(false),
+      slots_(slots < 1 ? 1 : slots) {}
 
-void WebServer::assign(const Request& r) {
-    // void return, assumes caller checks isIdle()
-    current_ = r;
-    remaining_ = r.time_required;
-    busy_ = true;
+bool WebServer::canAccept(char jobType) const {
+    if (jobType == 'S') return !exclusive_ && active_ < (int)slots_.size();
+    return active_ == 0;
 }
 
-void WebServer::tick() {
-    if (!busy_) return;
+void WebServer::assign(const Request& r, int cycles) {
+    // void return, assumes caller checks canAccept()
+    LB_ALLOC_SITE(SITE_SERVER_ASSIGN);
+    for (auto& slot : slots_) {
+        if (slot.busy) continue;
+        slot.req = r;
+        slot.remaining = cycles;
+        slot.busy = true;
+        break;
+    }
+    active_++;
+    if (r.job_type != 'S') exclusive_ = true;
+}
+
+int WebServer::tick() {
+    if (active_ == 0) return 0;
 
-    if (remaining_ > 0) remaining_--;
+    int finished = 0;
+    for (auto& slot : slots_) {
+        if (!slot.busy) continue;
 
-    if (remaining_ <= 0) {
-        busy_ = false;
-        remaining_ = 0;
-        current_.reset();
+        if (slot.remaining > 0) slot.remaining--;
+
+        if (slot.remaining <= 0) {
+            slot.busy = false;
+            slot.remaining = 0;
+            finished++;
+        }
     }
+
+    active_ -= finished;
+    if (active_ == 0) exclusive_ = false;
+    return finished;
 }
 
 bool WebServer::isIdle() const {
-    return !busy_;
-}
\ No newline at end of file
+    return active_ == 0;
+}
@@ -1,10 +1,84 @@
 #include <iostream>
 #include <algorithm>
+#include <chrono>
+#include <cmath>
 #include "Config.h"
 #include "Simulation.h"
 #include "ConfigLoader.h"
 #include "LoadBalancer.h"
 #include "Switch.h"
+#include "QueueEstimator.h"
+#include "LiveFrontend.h"
+#include "AllocProfiler.h"
+
+// analytic M/G/c estimate, timed; returns the estimator for validation
+static QueueEstimator runEstimate(const Config& cfg) {
+    auto start = std::chrono::steady_clock::now();
+    QueueEstimator est(cfg);
+    QueueEstimator::Estimate e = est.estimate(cfg.numServers);
+    QueueEstimator::AutoscalePrediction a = est.predictAutoscaler();
+    auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start);
+
+    std::cout << "\n=== Analytic Estimate (M/G/c, Allen-Cunneen) ===\n";
+    for (const std::string& line : est.reportLines(e, a)) {
+        std::cout << line << "\n";
+    }
+    std::cout << "Computed in " << elapsed.count() << " us\n";
+    std::cout << "================================================\n\n";
+    return est;
+}
+
+// estimate vs. simulated batch-means intervals
+static void printValidation(const Config& cfg, const QueueEstimator& est, const SteadyStateDetector& ss) {
+    SteadyStateDetector::Interval q = ss.interval(SteadyStateDetector::QUEUE);
+    SteadyStateDetector::Interval s = ss.interval(SteadyStateDetector::SERVERS);
+    SteadyStateDetector::Interval x = ss.interval(SteadyStateDetector::THROUGHPUT);
+
+    // compare queueing figures at the server count the simulation actually ran with
+    QueueEstimator::Estimate e = est.estimate(std::max(1, (int)std::lround(s.mean)));
+    QueueEstimator::AutoscalePrediction a = est.predictAutoscaler();
+
+    // with no rest state the scaler flips between low-1 and low servers and
+    // holds the queue between its thresholds, so M/G/c at one count does not
+    // apply; predict those bands instead
+    double sLo = a.settle, sHi = a.settle;
+    double qLo = e.queueLength, qHi = e.queueLength;
+    double wLo = e.waitTime, wHi = e.waitTime;
+    if (a.oscillates) {
+        sLo = std::max(1, a.low - 1);
+        sHi = a.low;
+        qLo = (double)cfg.minQueuePerServer * sLo;
+        qHi = (double)cfg.maxQueuePerServer * sHi;
+        wLo = qLo / e.arrivalRate;
+        wHi = qHi / e.arrivalRate;
+    }
+
+    // a point estimate is a band of width zero; the CI only has to touch it
+    auto row = [](const std::string& name, double lo, double hi, double mean, double hw) {
+        bool inside = mean + hw >= lo && mean - hw <= hi;
+        std::cout << name << ": estimate=";
+        if (lo == hi) std::cout << lo;
+        else std::cout << lo << ".." << hi;
+        std::cout << " simulated=" << mean << " +/- " << hw
+                  << (inside ? " (within CI)" : " (outside CI)") << "\n";
+    };
+
+    std::cout << "\n=== Estimator Validation ===\n";
+    std::cout << "Warm-up discarded: " << ss.warmupCycles() << " of "
+              << ss.cyclesRecorded() << " cycles\n";
+    row("Servers (autoscaler)", sLo, sHi, s.mean, s.halfWidth);
+    row("Throughput/cycle", e.throughput, e.throughput, x.mean, x.halfWidth);
+    row(a.oscillates ? "Queue length (scaler band)" : "Queue length", qLo, qHi, q.mean, q.halfWidth);
+    if (x.mean > 0.0) {
+        double w = q.mean / x.mean;
+        std::cout << "Wait (Little's law): estimate=";
+        if (wLo == wHi) std::cout << wLo;
+        else std::cout << wLo << ".." << wHi;
+        std::cout << " simulated=" << w << " cycles"
+                  << (w >= wLo && w <= wHi ? "" : " (outside estimate)") << "\n";
+    }
+    std::cout << "============================\n\n";
+}
 
 int main() {
     Config cfg;
@@ -34,13 +108,85 @@ int main() {
     std::cout << "===============================\n\n";
 
     int mode;
-    std::cout << "Mode (1 = single LB, 2 = switch bonus): ";
+    std::cout << "Mode (1 = single LB, 2 = switch bonus, 3 = analytic estimate, 4 = estimate + validate, 5 = live sockets): ";
     std::cin >> mode;
 
     if (mode == 1) {
         // ===== Single Load Balancer Mode =====
         Simulation sim(cfg);
         sim.runSimulation();
+        if (!sim.passed()) return 1;
+    }
+    else if (mode == 3) {
+        // ===== Analytic Estimate Only =====
+        runEstimate(cfg);
+    }
+    else if (mode == 4) {
+        // ===== Estimate, then check it against a single LB simulation =====
+        QueueEstimator est = runEstimate(cfg);
+        Simulation sim(cfg, true);
+        sim.runSimulation();
+        printValidation(cfg, est, sim.steadyState());
+        if (!sim.passed()) return 1;
+    }
+    else if (mode == 5) {
+        // ===== Live Mode: real requests over sockets, clock at liveTickHz =====
+        if (cfg.liveUseSwitch) {
+            Config streamCfg = cfg;
+            Config procCfg   = cfg;
+            streamCfg.numServers = std::max(1, cfg.numServers / 2);
+            procCfg.numServers   = std::max(1, cfg.numServers - streamCfg.numServers);
+
+            LoadBalancer streamLB(streamCfg, "STREAM", "logs/stream_lb.txt", false, false);
+            LoadBalancer procLB(procCfg, "PROC", "logs/proc_lb.txt", false, false);
+            Switch sw(cfg, streamLB, procLB, false);
+
+            LiveFrontend live(cfg,
+                              [&sw](const Request& r) { return sw.route(r); },
+                              [&sw]() { sw.step(); });
+            if (!live.start()) return 1;
+            live.run(cfg.totalCycles);
+            live.printSummary();
+            sw.summary();
+            if (!sw.passed()) return 1;
+        } else {
+            LoadBalancer lb(cfg, "LIVE", "logs/live_lb.txt", false, false);
+
+            int ticks = 0;
+            LiveFrontend live(cfg,
+                              [&lb](const Request& r) { return lb.addRequest(r); },
+                              [&lb, &cfg, &ticks]() {
+                                  if (cfg.allocSteadyStateAfter > 0 && ticks == cfg.allocSteadyStateAfter) {
+                                      AllocProfiler::beginSteadyState();
+                                  }
+                                  ticks++;
+                                  lb.dispatch();
+                                  lb.scaleServers();
+                              });
+            if (!live.start()) return 1;
+            live.run(cfg.totalCycles);
+            live.printSummary();
+            AllocProfiler::endSteadyState();
+
+            std::string failLine = AllocProfiler::steadyStateFailure(cfg.allocSteadyStateAfter);
+            bool allocFailed = cfg.allocFailOnSteadyState && cfg.allocSteadyStateAfter > 0 &&
+                               !failLine.empty();
+            if (allocFailed) {
+                std::cout << failLine << "\n";
+                lb.logLine(failLine);
+            }
+
+            if (AllocProfiler::enabled()) {
+                std::cout << "=== Allocation Profile ===\n";
+                for (const std::string& line : AllocProfiler::reportLines(lb.processed(), cfg.totalCycles)) {
+                    std::cout << line << "\n";
+                    lb.logLine(line);
+                }
+                std::cout << "\n";
+            }
+            lb.generateSummary();
+            if (allocFailed) return 1;
+        }
     }
     else {
         // ===== Switch Bonus Mode =====
@@ -62,7 +208,7 @@ int main() {
 
         Switch sw(cfg, streamLB, procLB);
 
-        RequestFactory rf(cfg);
+        RequestFactory rf(cfg, 2);
 
         for (int i = 0; i < cfg.numServers * cfg.initialQueueMultiplier; i++) {
             sw.route(rf.makeRequest());
@@ -73,5 +219,6 @@ int main() {
         }
 
         sw.summary();
+        if (!sw.passed()) return 1;
     }
 }
\ No newline at end of file
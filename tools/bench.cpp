@@ -0,0 +1,145 @@
+// lb_bench: seeded autoscaler stress benchmarks (make bench).
+//
+//   lb_bench [cycles]
+//
+// Runs each scenario below on a fresh single LoadBalancer built from Config
+// defaults (config.txt is ignored so results do not drift with local edits).
+// The LB starts with an empty queue, so lag and wait measure the scenario's
+// load rather than the initial backlog. Every scenario has a fixed seed, so
+// two runs print identical tables. Per-run logs go to logs/bench_<name>.txt.
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Config.h"
+#include "LoadBalancer.h"
+
+struct Scenario {
+    const char* name;
+    int seed;
+    int arrivalModel;
+    int taskTimeModel;
+    // bursts sized to outrun the scaler: one server per scaleCooldownN cycles
+    // raises the scale-up threshold by only maxQueuePerServer requests
+    double burstMultiplier;
+    double mmppToBurstProb;
+    double mmppToCalmProb;
+    int flashDecay;
+};
+
+static const Scenario SCENARIOS[] = {
+    {"baseline",  1001, ARRIVAL_BERNOULLI,   TASK_UNIFORM,   4.0, 0.001,  0.01,  1000},
+    {"mmpp",      1002, ARRIVAL_MMPP,        TASK_UNIFORM,  10.0, 0.0005, 0.002, 1000},
+    {"diurnal",   1003, ARRIVAL_DIURNAL,     TASK_UNIFORM,   4.0, 0.001,  0.01,  1000},
+    {"flash",     1004, ARRIVAL_FLASH_CROWD, TASK_UNIFORM,  10.0, 0.001,  0.01,  5000},
+    {"pareto",    1005, ARRIVAL_BERNOULLI,   TASK_PARETO,    4.0, 0.001,  0.01,  1000},
+    {"lognormal", 1006, ARRIVAL_BERNOULLI,   TASK_LOGNORMAL, 4.0, 0.001,  0.01,  1000},
+};
+
+struct BenchResult {
+    int peakQueue = 0;
+    int peakServers = 0;
+    long long scaleUps = 0;
+    long long scaleDowns = 0;
+    long long reversals = 0;  // scale direction flipped (up after down or down after up)
+    long long lagCycles = 0;  // queue above the scale-up threshold
+    int longestLag = 0;       // longest run of lag cycles: how long the scaler took to catch up
+    double meanQueue = 0.0;
+    double meanWait = 0.0;    // cycles queued per dispatched request
+    long long processed = 0;
+};
+
+static BenchResult runScenario(const Scenario& sc, int cycles) {
+    Config cfg;
+    cfg.totalCycles = cycles;
+    cfg.seed = sc.seed;
+    cfg.arrivalModel = sc.arrivalModel;
+    cfg.taskTimeModel = sc.taskTimeModel;
+    cfg.burstMultiplier = sc.burstMultiplier;
+    cfg.mmppToBurstProb = sc.mmppToBurstProb;
+    cfg.mmppToCalmProb = sc.mmppToCalmProb;
+    cfg.flashDecay = sc.flashDecay;
+    cfg.useColor = 0;
+    cfg.logCheckpointInterval = 0;
+    cfg.logVerboseDrops = 0;
+
+    BenchResult res;
+    std::string logFile = std::string("logs/bench_") + sc.name + ".txt";
+
+    // the LB narrates every scaling event on stdout; keep the table readable
+    std::ostringstream sink;
+    std::streambuf* saved = std::cout.rdbuf(sink.rdbuf());
+    {
+        LoadBalancer lb(cfg, "BENCH", logFile, false);
+        int lastServers = lb.serverCount();
+        int lastDirection = 0;
+        int lagRun = 0;
+        long long queueSum = 0;
+
+        for (int t = 0; t < cycles; t++) {
+            lb.dispatch();
+            lb.scaleServers();
+
+            int q = lb.queueSize();
+            int s = lb.serverCount();
+            queueSum += q;
+            if (q > res.peakQueue) res.peakQueue = q;
+            if (s > res.peakServers) res.peakServers = s;
+            if (q > cfg.maxQueuePerServer * s) {
+                res.lagCycles++;
+                if (++lagRun > res.longestLag) res.longestLag = lagRun;
+            } else {
+                lagRun = 0;
+            }
+
+            int direction = (s > lastServers) - (s < lastServers);
+            if (direction > 0) res.scaleUps++;
+            if (direction < 0) res.scaleDowns++;
+            if (direction != 0) {
+                if (lastDirection != 0 && direction != lastDirection) res.reversals++;
+                lastDirection = direction;
+            }
+            lastServers = s;
+
+            // std::cout is swapped out, don't let the discarded text pile up
+            if (t % 1000 == 0) sink.str("");
+        }
+
+        res.meanQueue = (double)queueSum / cycles;
+        res.meanWait = lb.averageWait();
+        res.processed = lb.processed();
+        lb.generateSummary();
+    }
+    std::cout.rdbuf(saved);
+    return res;
+}
+
+int main(int argc, char** argv) {
+    int cycles = argc > 1 ? std::atoi(argv[1]) : 20000;
+    if (cycles < 1) cycles = 20000;
+
+    std::cout << "=== Autoscaler benchmark (" << cycles << " cycles per scenario) ===\n";
+    std::cout << std::left << std::setw(11) << "scenario" << std::right
+              << std::setw(8) << "peakQ" << std::setw(10) << "meanQ"
+              << std::setw(8) << "peakS" << std::setw(6) << "up" << std::setw(6) << "down"
+              << std::setw(8) << "flips" << std::setw(8) << "lag" << std::setw(8) << "maxLag"
+              << std::setw(9) << "wait" << std::setw(11) << "processed" << "\n";
+
+    for (const Scenario& sc : SCENARIOS) {
+        BenchResult r = runScenario(sc, cycles);
+        std::cout << std::left << std::setw(11) << sc.name << std::right
+                  << std::setw(8) << r.peakQueue
+                  << std::setw(10) << std::fixed << std::setprecision(1) << r.meanQueue
+                  << std::setw(8) << r.peakServers << std::setw(6) << r.scaleUps
+                  << std::setw(6) << r.scaleDowns << std::setw(8) << r.reversals
+                  << std::setw(8) << r.lagCycles << std::setw(8) << r.longestLag
+                  << std::setw(9) << r.meanWait << std::setw(11) << r.processed << "\n";
+    }
+
+    std::cout << "flips = scale direction reversals, lag = cycles with queue above maxQueuePerServer * servers,\n"
+              << "maxLag = longest such run, wait = mean cycles queued per dispatched request\n";
+    return 0;
+}
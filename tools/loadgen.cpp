@@ -0,0 +1,151 @@
+// loadgen: local load generator for the load balancer's live mode (5).
+//
+//   loadgen tcp <port> [options]
+//   loadgen unix <path> [options]
+//
+// options:
+//   --rate N     requests per second (0 = as fast as possible, default)
+//   --count N    requests to send (default 100000; trace replay sends the whole trace)
+//   --batch N    requests per write (default 256)
+//   --trace F    replay F, one request per line: ip_in ip_out time type [priority]
+//
+// Synthetic requests come from RequestFactory using config.txt.
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Config.h"
+#include "ConfigLoader.h"
+#include "RequestFactory.h"
+#include "WireFormat.h"
+
+static int connectTcp(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static int connectUnix(const std::string& path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    if (connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static bool sendAll(int fd, const uint8_t* data, std::size_t len) {
+    while (len > 0) {
+        ssize_t n = send(fd, data, len, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        data += n;
+        len -= (std::size_t)n;
+    }
+    return true;
+}
+
+static std::vector<Request> loadTrace(const std::string& path) {
+    std::vector<Request> out;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream ls(line);
+        Request r;
+        r.priority = 0;
+        if (ls >> r.ip_in >> r.ip_out >> r.time_required >> r.job_type) {
+            ls >> r.priority;
+            out.push_back(r);
+        }
+    }
+    return out;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "usage: loadgen tcp <port> | unix <path> [--rate N] [--count N] [--batch N] [--trace F]\n";
+        return 2;
+    }
+
+    std::string kind = argv[1];
+    std::string target = argv[2];
+    double rate = 0.0;
+    long long count = 100000;
+    int batch = 256;
+    std::string tracePath;
+
+    for (int i = 3; i + 1 < argc; i += 2) {
+        std::string opt = argv[i];
+        if (opt == "--rate") rate = std::stod(argv[i + 1]);
+        else if (opt == "--count") count = std::stoll(argv[i + 1]);
+        else if (opt == "--batch") batch = std::max(1, std::stoi(argv[i + 1]));
+        else if (opt == "--trace") tracePath = argv[i + 1];
+    }
+
+    int fd = (kind == "unix") ? connectUnix(target) : connectTcp(std::stoi(target));
+    if (fd < 0) {
+        std::cerr << "loadgen: cannot connect to " << kind << ":" << target << "\n";
+        return 1;
+    }
+
+    Config cfg;
+    ConfigLoader::loadFromFile("config.txt", cfg);
+    RequestFactory factory(cfg);
+
+    std::vector<Request> trace;
+    if (!tracePath.empty()) {
+        trace = loadTrace(tracePath);
+        count = (long long)trace.size();
+    }
+
+    std::vector<uint8_t> buf((std::size_t)batch * WireFormat::RECORD_SIZE);
+    auto start = std::chrono::steady_clock::now();
+    long long sent = 0;
+
+    while (sent < count) {
+        int n = (int)std::min<long long>(batch, count - sent);
+        for (int i = 0; i < n; i++) {
+            const Request r = trace.empty() ? factory.makeRequest() : trace[(std::size_t)(sent + i)];
+            WireFormat::encode(r, (uint32_t)(sent + i), buf.data() + (std::size_t)i * WireFormat::RECORD_SIZE);
+        }
+        if (!sendAll(fd, buf.data(), (std::size_t)n * WireFormat::RECORD_SIZE)) {
+            std::cerr << "loadgen: connection closed after " << sent << " requests\n";
+            break;
+        }
+        sent += n;
+
+        // pace to --rate: sleep until this batch is due
+        if (rate > 0.0) {
+            auto due = start + std::chrono::duration<double>(sent / rate);
+            std::this_thread::sleep_until(due);
+        }
+    }
+
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    close(fd);
+
+    std::cout << "loadgen: sent " << sent << " requests in " << secs << " s ("
+              << (secs > 0.0 ? sent / secs : 0.0) << " requests/s)\n";
+    return 0;
+}